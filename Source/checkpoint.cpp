@@ -0,0 +1,389 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   C H E C K P O I N T E R   C L A S S                                                    */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "checkpoint.h"
+
+#include<fstream>
+#include<sstream>
+#include<stdio.h>
+#include<string.h>
+#include<fcntl.h>
+#include<unistd.h>
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+//--FNV-1a over 64-bit words, with a byte-wise tail--//
+static unsigned long long fnv1a(const void* data, const size_t bytes, unsigned long long hash)
+{
+    const unsigned char* p = (const unsigned char*) data;
+    size_t words = bytes / 8;
+
+    for(size_t w=0; w<words; w++)
+    {
+        unsigned long long word;
+        memcpy(&word, p + (w * 8), 8);
+
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+
+    for(size_t b=words*8; b<bytes; b++)
+    {
+        hash = (hash ^ p[b]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+template<typename T> static void append(string& buffer, const T& value)
+{
+    buffer.append((const char*) &value, sizeof(T));
+}
+
+template<typename T> static bool extract(const string& buffer, size_t& pos, T& value)
+{
+    if(pos + sizeof(T) > buffer.size())
+    {
+        return false;
+    }
+
+    memcpy(&value, buffer.data() + pos, sizeof(T));
+    pos += sizeof(T);
+
+    return true;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates an idle checkpointer. Checkpoints are written only between start() and stop().
+
+Checkpointer::Checkpointer()
+{
+    d_has_pending = false;
+    d_running = false;
+}
+
+
+// DESTRUCTOR
+
+/// Writes the pending checkpoint, if any, and stops the writer thread.
+
+Checkpointer::~Checkpointer()
+{
+    stop();
+}
+
+
+// void start(const string&) method
+
+/// Starts the background thread that writes submitted checkpoints to a file.
+/// @param path Path and name of the checkpoint file.
+
+void Checkpointer::start(const string& path)
+{
+    stop();
+
+    d_path = path;
+    d_has_pending = false;
+    d_running = true;
+
+    d_writer = thread(&Checkpointer::writer, this);
+}
+
+
+// void stop(void) method
+
+/// Waits for the pending checkpoint to be written and stops the writer thread.
+
+void Checkpointer::stop(void)
+{
+    if(!d_writer.joinable())
+    {
+        return;
+    }
+
+    {
+        unique_lock<mutex> lock(d_mutex);
+        d_running = false;
+    }
+    d_submitted.notify_one();
+
+    d_writer.join();
+}
+
+
+// bool isRunning(void) const method
+
+/// Returns true while the checkpointer accepts checkpoints.
+
+bool Checkpointer::isRunning(void) const
+{
+    return d_running;
+}
+
+
+// void submit(const Checkpoint&) method
+
+/// Hands a snapshot of the training state to the writer thread and returns without waiting for the write.
+/// If the writer is still busy, an older pending snapshot is replaced by the newer one.
+/// @param checkpoint Training state to be saved.
+
+void Checkpointer::submit(const Checkpoint& checkpoint)
+{
+    {
+        unique_lock<mutex> lock(d_mutex);
+        d_pending = checkpoint;
+        d_has_pending = true;
+    }
+    d_submitted.notify_one();
+}
+
+
+// bool load(const string&, Checkpoint&) method
+
+/// Reads and validates a checkpoint file.
+/// Returns false if the file is missing, truncated, of another version or fails its checksum.
+/// @param path Path and name of the checkpoint file.
+/// @param checkpoint Reference of Checkpoint object to hold the training state.
+
+bool Checkpointer::load(const string& path, Checkpoint& checkpoint)
+{
+    ifstream file(path.c_str(), ios::binary);
+    if(!file.is_open())
+    {
+        return false;
+    }
+
+    stringstream contents;
+    contents << file.rdbuf();
+    string buffer = contents.str();
+
+    if(buffer.size() < 4 + sizeof(unsigned long long) || buffer.compare(0, 4, "RGCK"))
+    {
+        return false;
+    }
+
+    unsigned long long checksum;
+    size_t payload = buffer.size() - sizeof(checksum);
+    memcpy(&checksum, buffer.data() + payload, sizeof(checksum));
+
+    if(checksum != fnv1a(buffer.data(), payload, FNV_OFFSET))
+    {
+        return false;
+    }
+
+    size_t pos = 4;
+    unsigned int version;
+    unsigned long long rows;
+    unsigned long long cols;
+    unsigned long long rng_size;
+
+    if(!extract(buffer, pos, version) || version != CHECKPOINT_VERSION ||
+       !extract(buffer, pos, checkpoint.iteration) ||
+       !extract(buffer, pos, checkpoint.cost) ||
+       !extract(buffer, pos, checkpoint.prev_cost) ||
+       !extract(buffer, pos, checkpoint.alpha) ||
+       !extract(buffer, pos, checkpoint.lamda) ||
+       !extract(buffer, pos, checkpoint.fingerprint) ||
+       !extract(buffer, pos, rows) ||
+       !extract(buffer, pos, cols))
+    {
+        return false;
+    }
+
+    if(pos + (rows * cols * sizeof(double)) > payload)
+    {
+        return false;
+    }
+
+    checkpoint.theta.set_size(rows, cols);
+    memcpy(checkpoint.theta.memptr(), buffer.data() + pos, rows * cols * sizeof(double));
+    pos += rows * cols * sizeof(double);
+
+    if(!extract(buffer, pos, rng_size) || pos + rng_size != payload)
+    {
+        return false;
+    }
+
+    checkpoint.rng_state.assign(buffer.data() + pos, rng_size);
+
+    return true;
+}
+
+
+// unsigned long long fingerprint(const mat&, const mat&) method
+
+/// Returns a 64-bit fingerprint of a data set, used to refuse resuming a run on different data.
+/// @param X Feature matrix were each row is an instance and each column is an attribute.
+/// @param Y Targets of the data set.
+
+unsigned long long Checkpointer::fingerprint(const mat& X, const mat& Y)
+{
+    unsigned long long dims[4] = {X.n_rows, X.n_cols, Y.n_rows, Y.n_cols};
+    unsigned long long hash = fnv1a(dims, sizeof(dims), FNV_OFFSET);
+
+    hash = fnv1a(X.memptr(), X.n_elem * sizeof(double), hash);
+    hash = fnv1a(Y.memptr(), Y.n_elem * sizeof(double), hash);
+
+    return hash;
+}
+
+
+// unsigned long long fingerprint(const QuantizedMatrix&, const mat&) method
+
+/// Returns a 64-bit fingerprint of an 8-bit data set, used to refuse resuming a run on different data.
+/// @param X Quantized feature matrix were each row is an instance and each column is an attribute.
+/// @param Y Targets of the data set.
+
+unsigned long long Checkpointer::fingerprint(const QuantizedMatrix& X, const mat& Y)
+{
+    unsigned long long dims[4] = {X.M(), X.N(), Y.n_rows, Y.n_cols};
+    double affine[2] = {X.scale(), X.offset()};
+    unsigned long long hash = fnv1a(dims, sizeof(dims), FNV_OFFSET);
+
+    hash = fnv1a(affine, sizeof(affine), hash);
+    hash = fnv1a(X.values().memptr(), X.memoryBytes(), hash);
+    hash = fnv1a(Y.memptr(), Y.n_elem * sizeof(double), hash);
+
+    return hash;
+}
+
+
+// unsigned long long fingerprint(const DataView&) method
+
+/// Returns a 64-bit fingerprint of the training data of a view: its underlying data set, and the rows it selects
+/// when it is a subset, so that a run is not resumed on another split of the same data.
+/// @param view View of the training instances.
+
+unsigned long long Checkpointer::fingerprint(const DataView& view)
+{
+    unsigned long long hash = view.quantized() ? fingerprint(view.Xq(), view.Y()) : fingerprint(view.X(), view.Y());
+
+    if(view.indexed() && view.M())
+    {
+        uvec rows;
+        view.rowIndices(0, view.M()-1, rows);
+
+        hash = fnv1a(rows.memptr(), rows.n_elem * sizeof(uword), hash);
+    }
+
+    return hash;
+}
+
+
+// void writer(void) method
+
+/// Writer thread loop: writes the latest submitted checkpoint, off the training thread.
+
+void Checkpointer::writer(void)
+{
+    Checkpoint checkpoint;
+
+    while(true)
+    {
+        {
+            unique_lock<mutex> lock(d_mutex);
+            d_submitted.wait(lock, [this]{ return d_has_pending || !d_running; });
+
+            if(!d_has_pending)
+            {
+                return;
+            }
+
+            swap(checkpoint, d_pending);
+            d_has_pending = false;
+        }
+
+        if(!write(d_path, checkpoint))
+        {
+            cerr << "Regression: Checkpointer class." << endl
+                 << "void writer(void) method" << endl
+                 << "Cannot write checkpoint file: " << d_path << endl;
+        }
+    }
+}
+
+
+// bool write(const string&, const Checkpoint&) method
+
+/// Writes a checkpoint crash-safely: the data is written and fsync'ed under a temporary name,
+/// then renamed over the previous checkpoint, so the file always holds one complete checkpoint.
+/// @param path Path and name of the checkpoint file.
+/// @param checkpoint Training state to be saved.
+
+bool Checkpointer::write(const string& path, const Checkpoint& checkpoint)
+{
+    string buffer("RGCK");
+    unsigned int version = CHECKPOINT_VERSION;
+    unsigned long long rows = checkpoint.theta.n_rows;
+    unsigned long long cols = checkpoint.theta.n_cols;
+    unsigned long long rng_size = checkpoint.rng_state.size();
+
+    append(buffer, version);
+    append(buffer, checkpoint.iteration);
+    append(buffer, checkpoint.cost);
+    append(buffer, checkpoint.prev_cost);
+    append(buffer, checkpoint.alpha);
+    append(buffer, checkpoint.lamda);
+    append(buffer, checkpoint.fingerprint);
+    append(buffer, rows);
+    append(buffer, cols);
+    buffer.append((const char*) checkpoint.theta.memptr(), checkpoint.theta.n_elem * sizeof(double));
+    append(buffer, rng_size);
+    buffer.append(checkpoint.rng_state);
+    append(buffer, fnv1a(buffer.data(), buffer.size(), FNV_OFFSET));
+
+    string tmp_path = path + ".tmp";
+
+    int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    size_t written = 0;
+    while(written < buffer.size())
+    {
+        ssize_t w = ::write(fd, buffer.data() + written, buffer.size() - written);
+        if(w <= 0)
+        {
+            close(fd);
+            return false;
+        }
+        written += w;
+    }
+
+    bool synced = !fsync(fd);
+    bool closed = !close(fd);
+
+    if(!synced || !closed || rename(tmp_path.c_str(), path.c_str()))
+    {
+        return false;
+    }
+
+    //--Persist the rename itself--//
+    size_t found = path.find_last_of("/");
+    string dir = (found == string::npos) ? "." : path.substr(0, found+1);
+
+    int dir_fd = open(dir.c_str(), O_RDONLY);
+    if(dir_fd >= 0)
+    {
+        fsync(dir_fd);
+        close(dir_fd);
+    }
+
+    return true;
+}
@@ -0,0 +1,78 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   C H E C K P O I N T E R   C L A S S   H E A D E R                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include<iostream>
+#include<string>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+
+#include "armadillo"
+#include "quantized_matrix.h"
+#include "data_view.h"
+
+using namespace std;
+using namespace arma;
+
+#define CHECKPOINT_VERSION 1
+
+struct Checkpoint
+{
+    mat theta;
+    unsigned int iteration;             //--Last completed iteration--//
+    double cost;                        //--J(Ө) at that iteration--//
+    double prev_cost;                   //--J(Ө) at the iteration before--//
+    double alpha;
+    double lamda;
+    string rng_state;                   //--Serialized state of the model's random engine--//
+    unsigned long long fingerprint;     //--Fingerprint of the training data--//
+};
+
+class Checkpointer
+{
+public:
+    Checkpointer();
+    ~Checkpointer();
+
+    void start(const string&);
+    void stop(void);
+    bool isRunning(void) const;
+
+    void submit(const Checkpoint&);
+
+    static bool load(const string&, Checkpoint&);
+    static unsigned long long fingerprint(const mat&, const mat&);
+    static unsigned long long fingerprint(const QuantizedMatrix&, const mat&);
+    static unsigned long long fingerprint(const DataView&);
+
+private:
+    void writer(void);
+    static bool write(const string&, const Checkpoint&);
+
+    string d_path;
+
+    Checkpoint d_pending;
+    bool d_has_pending;
+    bool d_running;
+
+    mutex d_mutex;
+    condition_variable d_submitted;
+    thread d_writer;
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,340 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   C L A S S I F I C A T I O N   M E T R I C S   C L A S S                                */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "classification_metrics.h"
+
+#include<thread>
+#include<vector>
+
+//--Counts the pairs [first, last) into a column-major KxK histogram--//
+static void countPairs(const uword* actual, const uword* predicted, const uword first, const uword last,
+                       const uword classes, uword* counts)
+{
+    for(uword i=first; i<last; i++)
+    {
+        counts[actual[i] + (predicted[i] * classes)]++;
+    }
+}
+
+static double safeRatio(const double numerator, const double denominator)
+{
+    return denominator ? (numerator / denominator) : 0.0;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates an empty confusion matrix.
+/// @param classes Number of classes K > 0.
+/// @param threads Number of threads counting a large batch > 0.
+
+ClassificationMetrics::ClassificationMetrics(const unsigned int classes, const unsigned int threads)
+{
+    if(!classes || !threads)
+    {
+        cerr << "Regression: ClassificationMetrics class." << endl
+             << "ClassificationMetrics(const unsigned int, const unsigned int) constructor." << endl
+             << "Classes: " << classes << " and threads: " << threads << " must both be > 0."
+             << endl;
+
+        exit(1);
+    }
+
+    d_threads = threads;
+    d_confusion = zeros<umat>(classes, classes);
+}
+
+
+// void reset(void) method
+
+/// Clears the counts.
+
+void ClassificationMetrics::reset(void)
+{
+    d_confusion.zeros();
+}
+
+
+// void accumulate(const uvec&, const uvec&) method
+
+/// Adds a batch of instances to the confusion matrix in one histogram pass. Large batches are split across
+/// the threads, each counting into a private KxK histogram, and the histograms are summed at the end.
+/// @param actual True class index of each instance < K.
+/// @param predicted Predicted class index of each instance < K.
+
+void ClassificationMetrics::accumulate(const uvec& actual, const uvec& predicted)
+{
+    uword m = actual.n_elem;
+    uword classes = d_confusion.n_rows;
+
+    if(predicted.n_elem != m)
+    {
+        cerr << "Regression: ClassificationMetrics class." << endl
+             << "void accumulate(const uvec&, const uvec&) method." << endl
+             << "Size of vectors actual: " << m << " and predicted: " << predicted.n_elem << " must be equal."
+             << endl;
+
+        exit(1);
+    }
+
+    if(!m)
+    {
+        return;
+    }
+
+    if(actual.max() >= classes || predicted.max() >= classes)
+    {
+        cerr << "Regression: ClassificationMetrics class." << endl
+             << "void accumulate(const uvec&, const uvec&) method." << endl
+             << "Class indices must be < number of classes: " << classes
+             << endl;
+
+        exit(1);
+    }
+
+    unsigned int threads = (m >= METRICS_PARALLEL_MIN) ? d_threads : 1;
+
+    if(threads == 1)
+    {
+        countPairs(actual.memptr(), predicted.memptr(), 0, m, classes, d_confusion.memptr());
+        return;
+    }
+
+    vector< vector<uword> > counts(threads, vector<uword>(classes * classes, 0));
+    vector<thread> workers;
+
+    for(unsigned int t=0; t<threads; t++)
+    {
+        workers.push_back(thread(countPairs, actual.memptr(), predicted.memptr(), (m * t) / threads, (m * (t+1)) / threads,
+                                 classes, &counts[t][0]));
+    }
+
+    uword* confusion = d_confusion.memptr();
+
+    for(unsigned int t=0; t<threads; t++)
+    {
+        workers[t].join();
+
+        for(uword c=0; c<classes*classes; c++)
+        {
+            confusion[c] += counts[t][c];
+        }
+    }
+}
+
+
+// void merge(const ClassificationMetrics&) method
+
+/// Adds the counts of another set of metrics over the same classes, e.g. one gathered on another thread.
+/// @param other Metrics over K classes.
+
+void ClassificationMetrics::merge(const ClassificationMetrics& other)
+{
+    if(other.K() != K())
+    {
+        cerr << "Regression: ClassificationMetrics class." << endl
+             << "void merge(const ClassificationMetrics&) method." << endl
+             << "Classes: " << other.K() << " must be equal to " << K() << "."
+             << endl;
+
+        exit(1);
+    }
+
+    d_confusion += other.d_confusion;
+}
+
+
+// unsigned int K(void) const method
+
+/// Returns the number of classes.
+
+unsigned int ClassificationMetrics::K(void) const
+{
+    return d_confusion.n_rows;
+}
+
+
+// uword total(void) const method
+
+/// Returns the number of instances accumulated.
+
+uword ClassificationMetrics::total(void) const
+{
+    return accu(d_confusion);
+}
+
+
+// const umat& confusionMatrix(void) const method
+
+/// Returns the KxK confusion matrix: actual class by row, predicted class by column.
+
+const umat& ClassificationMetrics::confusionMatrix(void) const
+{
+    return d_confusion;
+}
+
+
+// vec precision(void) const method
+
+/// Returns the precision of each class: TP_k / (TP_k + FP_k).
+
+vec ClassificationMetrics::precision(void) const
+{
+    urowvec predicted = sum(d_confusion, 0);
+    vec p(K());
+
+    for(unsigned int k=0; k<K(); k++)
+    {
+        p(k) = safeRatio(d_confusion(k,k), predicted(k));
+    }
+
+    return p;
+}
+
+
+// vec recall(void) const method
+
+/// Returns the recall of each class: TP_k / (TP_k + FN_k).
+
+vec ClassificationMetrics::recall(void) const
+{
+    ucolvec actual = sum(d_confusion, 1);
+    vec r(K());
+
+    for(unsigned int k=0; k<K(); k++)
+    {
+        r(k) = safeRatio(d_confusion(k,k), actual(k));
+    }
+
+    return r;
+}
+
+
+// vec f1(void) const method
+
+/// Returns the F1 score of each class: 2TP_k / (2TP_k + FP_k + FN_k).
+
+vec ClassificationMetrics::f1(void) const
+{
+    urowvec predicted = sum(d_confusion, 0);
+    ucolvec actual = sum(d_confusion, 1);
+    vec f(K());
+
+    for(unsigned int k=0; k<K(); k++)
+    {
+        f(k) = safeRatio(2.0 * d_confusion(k,k), (double) predicted(k) + actual(k));
+    }
+
+    return f;
+}
+
+
+// double accuracy(void) const method
+
+/// Returns the fraction of instances classified correctly.
+
+double ClassificationMetrics::accuracy(void) const
+{
+    return safeRatio(trace(d_confusion), total());
+}
+
+
+// double macroPrecision(void) const method
+
+/// Returns the precision averaged over the classes, each class weighing the same.
+
+double ClassificationMetrics::macroPrecision(void) const
+{
+    return mean(precision());
+}
+
+
+// double macroRecall(void) const method
+
+/// Returns the recall averaged over the classes, each class weighing the same.
+
+double ClassificationMetrics::macroRecall(void) const
+{
+    return mean(recall());
+}
+
+
+// double macroF1(void) const method
+
+/// Returns the F1 score averaged over the classes, each class weighing the same.
+
+double ClassificationMetrics::macroF1(void) const
+{
+    return mean(f1());
+}
+
+
+// double microPrecision(void) const method
+
+/// Returns the precision over the TP and FP of all classes pooled, each instance weighing the same.
+
+double ClassificationMetrics::microPrecision(void) const
+{
+    //--∑FP_k = ∑FN_k = total - ∑TP_k, since each instance has exactly one actual and one predicted class--//
+    return safeRatio(trace(d_confusion), total());
+}
+
+
+// double microRecall(void) const method
+
+/// Returns the recall over the TP and FN of all classes pooled, each instance weighing the same.
+
+double ClassificationMetrics::microRecall(void) const
+{
+    return safeRatio(trace(d_confusion), total());
+}
+
+
+// double microF1(void) const method
+
+/// Returns the F1 score of the micro precision and recall.
+
+double ClassificationMetrics::microF1(void) const
+{
+    double p = microPrecision();
+    double r = microRecall();
+
+    return safeRatio(2.0 * p * r, p + r);
+}
+
+
+// void print(const vec&) const method
+
+/// Prints the precision, recall, F1 and support of each class, then the macro and micro averages.
+/// @param labels Label of each class.
+
+void ClassificationMetrics::print(const vec& labels) const
+{
+    vec p = precision();
+    vec r = recall();
+    vec f = f1();
+    ucolvec support = sum(d_confusion, 1);
+
+    cout << endl << "#Class  #Precision  #Recall  #F1  #Support" << endl;
+
+    for(unsigned int k=0; k<K(); k++)
+    {
+        cout << ((k < labels.n_elem) ? labels(k) : k) << "  " << p(k) << "  " << r(k) << "  " << f(k) << "  " << support(k) << endl;
+    }
+
+    cout << "Macro  " << macroPrecision() << "  " << macroRecall() << "  " << macroF1() << "  " << total() << endl
+         << "Micro  " << microPrecision() << "  " << microRecall() << "  " << microF1() << "  " << total() << endl
+         << endl << "Accuracy: " << accuracy() << endl;
+}
@@ -0,0 +1,63 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   C L A S S I F I C A T I O N   M E T R I C S   C L A S S   H E A D E R                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef CLASSIFICATION_METRICS_H
+#define CLASSIFICATION_METRICS_H
+
+#include<iostream>
+
+#include "armadillo"
+
+using namespace std;
+using namespace arma;
+
+#define METRICS_PARALLEL_MIN 65536      //--Instances below which a batch is counted on the calling thread--//
+
+//--KxK confusion matrix, actual class by row and predicted class by column, accumulated over any number--//
+//--of batches, and the per-class, macro and micro precision, recall and F1 derived from it. A class    --//
+//--with no predictions or no instances scores 0 where its ratio would be 0/0.                         --//
+class ClassificationMetrics
+{
+public:
+    ClassificationMetrics(const unsigned int, const unsigned int);
+
+    void reset(void);
+    void accumulate(const uvec&, const uvec&);
+    void merge(const ClassificationMetrics&);
+
+    unsigned int K(void) const;
+    uword total(void) const;
+    const umat& confusionMatrix(void) const;
+
+    vec precision(void) const;
+    vec recall(void) const;
+    vec f1(void) const;
+
+    double accuracy(void) const;
+    double macroPrecision(void) const;
+    double macroRecall(void) const;
+    double macroF1(void) const;
+    double microPrecision(void) const;
+    double microRecall(void) const;
+    double microF1(void) const;
+
+    void print(const vec&) const;
+
+private:
+    unsigned int d_threads;
+    umat d_confusion;
+};
+
+#endif // CLASSIFICATION_METRICS_H
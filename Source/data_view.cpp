@@ -0,0 +1,390 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   D A T A   V I E W   C L A S S                                                          */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "data_view.h"
+
+#define SPARSE_TILE_ROWS 256
+
+// CONSTRUCTOR
+
+/// Creates a view over all the instances of a data set, in their stored order.
+/// @param X Feature matrix were each row is an instance and each column is an attribute.
+/// @param Y Targets of the instances, in the layout expected by the model (Mx1 or KxM).
+/// @param labels Encoding of Y.
+
+DataView::DataView(const mat& X, const mat& Y, const Labels labels):d_X(&X), d_Xq(NULL), d_Y(Y), d_labels(labels)
+{
+    d_indexed = false;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a view over a subset of the instances of a data set, without copying them.
+/// @param X Feature matrix were each row is an instance and each column is an attribute.
+/// @param Y Targets of the instances, in the layout expected by the model (Mx1 or KxM).
+/// @param labels Encoding of Y.
+/// @param rows Indices of the rows of X that belong to the view.
+
+DataView::DataView(const mat& X, const mat& Y, const Labels labels, const uvec& rows):d_X(&X), d_Xq(NULL), d_Y(Y), d_labels(labels), d_rows(rows)
+{
+    if(!rows.is_empty() && rows.max() >= X.n_rows)
+    {
+        cerr << "Regression: DataView class." << endl
+             << "DataView(const mat&, const mat&, const Labels, const uvec&) constructor." << endl
+             << "Row index: " << rows.max() << " is out of range of matrix X with " << X.n_rows << " rows."
+             << endl;
+
+        exit(1);
+    }
+
+    d_indexed = true;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a view over all the instances of an 8-bit data set, which are dequantized one tile at a time.
+/// @param X Quantized feature matrix were each row is an instance and each column is an attribute.
+/// @param Y Targets of the instances, in the layout expected by the model (Mx1 or KxM).
+/// @param labels Encoding of Y.
+
+DataView::DataView(const QuantizedMatrix& X, const mat& Y, const Labels labels):d_X(NULL), d_Xq(&X), d_Y(Y), d_labels(labels)
+{
+    d_indexed = false;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a view over a subset of the instances of an 8-bit data set, which are dequantized one tile at a time.
+/// @param X Quantized feature matrix were each row is an instance and each column is an attribute.
+/// @param Y Targets of the instances, in the layout expected by the model (Mx1 or KxM).
+/// @param labels Encoding of Y.
+/// @param rows Indices of the rows of X that belong to the view.
+
+DataView::DataView(const QuantizedMatrix& X, const mat& Y, const Labels labels, const uvec& rows):d_X(NULL), d_Xq(&X), d_Y(Y), d_labels(labels), d_rows(rows)
+{
+    if(!rows.is_empty() && rows.max() >= X.M())
+    {
+        cerr << "Regression: DataView class." << endl
+             << "DataView(const QuantizedMatrix&, const mat&, const Labels, const uvec&) constructor." << endl
+             << "Row index: " << rows.max() << " is out of range of matrix X with " << X.M() << " rows."
+             << endl;
+
+        exit(1);
+    }
+
+    d_indexed = true;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a view over the same instances as another view, paired with other targets.
+/// @param view View whose feature matrix and rows are shared.
+/// @param Y Targets of the instances, indexed by the rows of the underlying feature matrix.
+/// @param labels Encoding of Y.
+
+DataView::DataView(const DataView& view, const mat& Y, const Labels labels):d_X(view.d_X), d_Xq(view.d_Xq), d_Y(Y), d_labels(labels),
+    d_rows(view.d_rows)
+{
+    d_indexed = view.d_indexed;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a view over a subset of the instances of another view, e.g. one fold of a training split.
+/// @param view View whose feature matrix and targets are shared.
+/// @param positions Positions, in the view, of the instances that belong to the new view.
+
+DataView::DataView(const DataView& view, const uvec& positions):d_X(view.d_X), d_Xq(view.d_Xq), d_Y(view.d_Y), d_labels(view.d_labels)
+{
+    if(!positions.is_empty() && positions.max() >= view.M())
+    {
+        cerr << "Regression: DataView class." << endl
+             << "DataView(const DataView&, const uvec&) constructor." << endl
+             << "Position: " << positions.max() << " is out of range of a view with " << view.M() << " instances."
+             << endl;
+
+        exit(1);
+    }
+
+    //--Positions are mapped to the rows of the underlying feature matrix, so views never nest--//
+    if(view.d_indexed)
+    {
+        d_rows = view.d_rows.elem(positions);
+    }
+    else
+    {
+        d_rows = positions;
+    }
+
+    d_indexed = true;
+}
+
+
+// unsigned int M(void) const method
+
+/// Returns the number of instances in the view.
+
+unsigned int DataView::M(void) const
+{
+    if(d_indexed)
+    {
+        return d_rows.n_rows;
+    }
+
+    return d_Xq ? d_Xq->M() : d_X->n_rows;
+}
+
+
+// unsigned int N(void) const method
+
+/// Returns the number of attributes of the instances in the view.
+
+unsigned int DataView::N(void) const
+{
+    return d_Xq ? d_Xq->N() : d_X->n_cols;
+}
+
+
+// bool quantized(void) const method
+
+/// Returns true if the underlying feature matrix is stored in 8 bits.
+
+bool DataView::quantized(void) const
+{
+    return d_Xq != NULL;
+}
+
+
+// bool indexed(void) const method
+
+/// Returns true if the view is over a subset of the rows of the underlying feature matrix.
+
+bool DataView::indexed(void) const
+{
+    return d_indexed;
+}
+
+
+// const mat& X(void) const method
+
+/// Returns a reference to the underlying feature matrix. Only valid for views that are not quantized.
+
+const mat& DataView::X(void) const
+{
+    if(!d_X)
+    {
+        cerr << "Regression: DataView class." << endl
+             << "const mat& X(void) const method." << endl
+             << "The view is over a quantized matrix; use Xq() instead."
+             << endl;
+
+        exit(1);
+    }
+
+    return *d_X;
+}
+
+
+// const QuantizedMatrix& Xq(void) const method
+
+/// Returns a reference to the underlying quantized feature matrix. Only valid for quantized views.
+
+const QuantizedMatrix& DataView::Xq(void) const
+{
+    if(!d_Xq)
+    {
+        cerr << "Regression: DataView class." << endl
+             << "const QuantizedMatrix& Xq(void) const method." << endl
+             << "The view is over a dense matrix; use X() instead."
+             << endl;
+
+        exit(1);
+    }
+
+    return *d_Xq;
+}
+
+
+// const mat& Y(void) const method
+
+/// Returns a reference to the underlying targets, indexed by the rows of the underlying feature matrix.
+
+const mat& DataView::Y(void) const
+{
+    return d_Y;
+}
+
+
+// Labels labels(void) const method
+
+/// Returns the encoding of the targets, as given when the view was built.
+
+DataView::Labels DataView::labels(void) const
+{
+    return d_labels;
+}
+
+
+// bool classIndexed(void) const method
+
+/// Returns true if the targets are an Mx1 vector of class indices.
+
+bool DataView::classIndexed(void) const
+{
+    return d_labels == ClassIndices;
+}
+
+
+// uword index(const uword) const method
+
+/// Returns the row of the underlying feature matrix holding the i-th instance of the view.
+/// @param i Position of the instance in the view.
+
+uword DataView::index(const uword i) const
+{
+    return d_indexed ? d_rows(i) : i;
+}
+
+
+// void rowIndices(const uword, const uword, uvec&) const method
+
+/// Fills a vector with the underlying rows of the instances [first, last] of the view.
+/// @param first Position of the first instance.
+/// @param last Position of the last instance.
+/// @param rows Reference of Armadillo::uvec object to hold the row indices.
+
+void DataView::rowIndices(const uword first, const uword last, uvec& rows) const
+{
+    rows.set_size(last - first + 1);
+
+    for(uword t=0; t<rows.n_rows; t++)
+    {
+        rows(t) = index(first + t);
+    }
+}
+
+
+// void loadTile(const uword, const uword, mat&) const method
+
+/// Gathers the instances [first, last] of the view into a contiguous tile, with a leading bias column of 1s.
+/// Only the tile is written; the underlying feature matrix is never copied.
+/// @param first Position of the first instance.
+/// @param last Position of the last instance.
+/// @param tile Reference of Armadillo::mat object to hold the tile.
+
+void DataView::loadTile(const uword first, const uword last, mat& tile) const
+{
+    uword rows = last - first + 1;
+    uword n = N();
+
+    tile.set_size(rows, n + 1);
+    tile.col(0).ones();
+
+    if(d_Xq)
+    {
+        //--Dequantized column by column, so the 8-bit source is read once and only the tile is in doubles--//
+        double scale = d_Xq->scale();
+        double offset = d_Xq->offset();
+
+        for(uword c=0; c<n; c++)
+        {
+            const unsigned char* q = d_Xq->values().colptr(c);
+            double* t = tile.colptr(c + 1);
+
+            if(!d_indexed)
+            {
+                q += first;
+
+                for(uword r=0; r<rows; r++)
+                {
+                    t[r] = scale * q[r] + offset;
+                }
+            }
+            else
+            {
+                for(uword r=0; r<rows; r++)
+                {
+                    t[r] = scale * q[d_rows(first + r)] + offset;
+                }
+            }
+        }
+
+        return;
+    }
+
+    if(!d_indexed)
+    {
+        tile.cols(1, n) = d_X->rows(first, last);
+        return;
+    }
+
+    for(uword c=0; c<n; c++)
+    {
+        const double* x = d_X->colptr(c);
+        double* t = tile.colptr(c + 1);
+
+        for(uword r=0; r<rows; r++)
+        {
+            t[r] = x[d_rows(first + r)];
+        }
+    }
+}
+
+
+// sp_mat sparseTranspose(void) const method
+
+/// Returns X' of the instances of the view as a sparse matrix, with one column per instance and no bias row.
+/// The instances are gathered one tile at a time, so a quantized or indexed X is never expanded whole.
+
+sp_mat DataView::sparseTranspose(void) const
+{
+    uword m = M();
+    uword n = N();
+
+    vector<uword> row_indices;
+    vector<double> values;
+    uvec col_ptrs(m + 1);
+    col_ptrs(0) = 0;
+
+    mat tile;
+
+    for(uword first=0; first<m; first+=SPARSE_TILE_ROWS)
+    {
+        uword last = (first + SPARSE_TILE_ROWS < m) ? (first + SPARSE_TILE_ROWS - 1) : (m - 1);
+        loadTile(first, last, tile);
+
+        //--Column 0 of the tile is the bias, which the sparse kernels fold in themselves--//
+        for(uword r=0; r<tile.n_rows; r++)
+        {
+            for(uword c=1; c<=n; c++)
+            {
+                if(tile(r, c) != 0.0)
+                {
+                    row_indices.push_back(c - 1);
+                    values.push_back(tile(r, c));
+                }
+            }
+
+            col_ptrs(first + r + 1) = values.size();
+        }
+    }
+
+    return sp_mat(conv_to<uvec>::from(row_indices), col_ptrs, conv_to<vec>::from(values), n, m);
+}
@@ -0,0 +1,69 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   D A T A   V I E W   C L A S S   H E A D E R                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef DATA_VIEW_H
+#define DATA_VIEW_H
+
+#include<iostream>
+#include<vector>
+
+#include "armadillo"
+#include "quantized_matrix.h"
+
+using namespace std;
+using namespace arma;
+
+class DataView
+{
+public:
+    //--Encoding of Y, given by whoever builds the view and never guessed from its shape:                --//
+    //--  Targets:      MxT targets, or a KxM one-hot matrix, indexed by the rows of the feature matrix   --//
+    //--  ClassIndices: Mx1 class indices, indexed by the rows of the feature matrix                      --//
+    enum Labels{Targets, ClassIndices};
+
+    DataView(const mat&, const mat&, const Labels);
+    DataView(const mat&, const mat&, const Labels, const uvec&);
+    DataView(const QuantizedMatrix&, const mat&, const Labels);
+    DataView(const QuantizedMatrix&, const mat&, const Labels, const uvec&);
+    DataView(const DataView&, const mat&, const Labels);
+    DataView(const DataView&, const uvec&);
+
+    unsigned int M(void) const;
+    unsigned int N(void) const;
+
+    bool quantized(void) const;
+    bool indexed(void) const;
+    const mat& X(void) const;
+    const QuantizedMatrix& Xq(void) const;
+    const mat& Y(void) const;
+    Labels labels(void) const;
+    bool classIndexed(void) const;
+
+    uword index(const uword) const;
+    void rowIndices(const uword, const uword, uvec&) const;
+    void loadTile(const uword, const uword, mat&) const;
+    sp_mat sparseTranspose(void) const;
+
+private:
+    const mat* d_X;
+    const QuantizedMatrix* d_Xq;
+    const mat& d_Y;
+    Labels d_labels;
+
+    uvec d_rows;
+    bool d_indexed;
+};
+
+#endif // DATA_VIEW_H
@@ -15,6 +15,8 @@
 
 #include "dataset.h"
 
+#include<algorithm>
+
 // CONSTRUCTOR
 
 /// Creates a Data Set object.
@@ -23,13 +25,15 @@
 /// @param trainPercent Training split of the data set > 0%.
 /// @param testPercent Test split of the data set ≥ 0%.
 /// @param MNIST Indicates if dataset is MNIST or not.
+/// @param stratify Splits each class of the data set at the training and test percentages. Ignored for MNIST, which comes split.
 
-DataSet::DataSet(const char* fileName, const unsigned int degree=1, const double trainPercent=70, const double testPercent=30, const bool MNIST=false)
+DataSet::DataSet(const char* fileName, const unsigned int degree=1, const double trainPercent=70, const double testPercent=30, const bool MNIST=false,
+                 const bool stratify=false)
 {
     if(!fileName)
     {
         cerr << "Regression: DataSet class." << endl
-             << "DataSet(const char*, const unsigned int, const double, const double, const bool) constructor." << endl
+             << "DataSet(const char*, const unsigned int, const double, const double, const bool, const bool) constructor." << endl
              << "Cannot open data file: " << fileName
              << endl;
 
@@ -39,7 +43,7 @@ DataSet::DataSet(const char* fileName, const unsigned int degree=1, const double
     if(degree == 0)
     {
         cerr << "Regression: DataSet class." << endl
-             << "DataSet(const char*, const unsigned int, const double, const double, const bool) constructor." << endl
+             << "DataSet(const char*, const unsigned int, const double, const double, const bool, const bool) constructor." << endl
              << "Parameter degree: " << degree << " for polynomial feature mapping has to be >= 1 "
              << endl;
 
@@ -49,7 +53,7 @@ DataSet::DataSet(const char* fileName, const unsigned int degree=1, const double
     if(trainPercent <= 0.0 || testPercent < 0.0)
     {
         cerr << "Regression: DataSet class." << endl
-             << "DataSet(const char*, const unsigned int, const double, const double, const bool) constructor." << endl
+             << "DataSet(const char*, const unsigned int, const double, const double, const bool, const bool) constructor." << endl
              << "Training set = " << trainPercent << "% has to be > 0% and Test set = "<< testPercent << "% has to be >= 0%."
              << endl;
 
@@ -59,13 +63,16 @@ DataSet::DataSet(const char* fileName, const unsigned int degree=1, const double
     if(trainPercent + testPercent != 100.0)
     {
         cerr << "Regression: DataSet class." << endl
-             << "DataSet(const char*, const unsigned int, const double, const double, const bool) constructor." << endl
+             << "DataSet(const char*, const unsigned int, const double, const double, const bool, const bool) constructor." << endl
              << "Training set = " << trainPercent << " + Test set = "<< testPercent << " has to be equal to 100%."
              << endl;
 
         exit(1);
     }
 
+    //--MNIST pixels are taken as they are, without feature mapping--//
+    d_degree = MNIST ? 1 : degree;
+
     if(MNIST)
     {
         string filePath(fileName);
@@ -76,7 +83,7 @@ DataSet::DataSet(const char* fileName, const unsigned int degree=1, const double
     }
     else
     {
-        extractDataFromFile(fileName, degree, trainPercent, testPercent);
+        extractDataFromFile(fileName, degree, trainPercent, testPercent, stratify);
     }
 }
 
@@ -84,8 +91,9 @@ DataSet::DataSet(const char* fileName, const unsigned int degree=1, const double
 // void extractMNISTData(const string) method.
 
 /// Extracts training and test data and the respective labels from MNIST dataset, the path of which is passed as a parameter.
-/// Encodes labels as one-hot vector format.
-/// Normalizes the training and test dat sets.
+/// Encodes labels as class indices.
+/// Keeps the training and test images as 8-bit pixels, normalized through the scale and offset of each set.
+/// Dense XTrain and XTest are expanded only on request.
 /// @param filePath Path of the file containing MNIST dataset.
 
 void DataSet::extractMNISTData(const string filePath)
@@ -104,30 +112,29 @@ void DataSet::extractMNISTData(const string filePath)
     cout << "Test labels file: " << test_label << endl;
 
     //--Extract training data and labels--//
-    extractMNISTimg(train_img, d_train_img_cube);
+    extractMNISTimg(train_img, d_X_train_q);
     extractMNISTlabel(train_label, d_train_label_vec);
 
     //--Extract training data and labels--//
-    extractMNISTimg(test_img, d_test_img_cube);
+    extractMNISTimg(test_img, d_X_test_q);
     extractMNISTlabel(test_label, d_test_label_vec);
 
     //--Extract unique labels and sort them--//
     d_class = sort(unique(d_train_label_vec));
 
-    //--Encode training and test labels into one-hot format--//
-    oneHotEncode(d_train_label_vec, d_train_1hot_mat);
-    oneHotEncode(d_test_label_vec, d_test_1hot_mat);
-
-    //--Normalize traininga and test data--//
-    normalizeFeatures(d_train_img_cube);
-    normalizeFeatures(d_test_img_cube);
+    //--Encode training and test labels as class indices; one-hot matrices are built only on request--//
+    classIndexEncode(d_train_label_vec, d_train_class_idx);
+    classIndexEncode(d_test_label_vec, d_test_class_idx);
 
-    unrollCubetoMatrix(d_train_img_cube, d_X_train);
-    unrollCubetoMatrix(d_test_img_cube, d_X_test);
+    //--μ and σ that reproduce the normalization of the training set, for models served on raw pixels--//
+    d_mu = ones<vec>(d_X_train_q.N()) * (-d_X_train_q.offset() / d_X_train_q.scale());
+    d_sigma = ones<vec>(d_X_train_q.N()) / d_X_train_q.scale();
 
-    cout << endl << "Number of training instances: " << d_X_train.n_rows << endl;
-    cout << endl << "Number of test instances: " << d_X_test.n_rows << endl;
-    cout << endl << "Number of attributes per instance: " << d_X_train.n_cols << endl;
+    cout << endl << "Number of training instances: " << d_X_train_q.M() << endl;
+    cout << endl << "Number of test instances: " << d_X_test_q.M() << endl;
+    cout << endl << "Number of attributes per instance: " << d_X_train_q.N() << endl;
+    cout << endl << "Training set: " << d_X_train_q.memoryBytes() / 1048576.0 << " MB in 8 bits ("
+         << (d_X_train_q.memoryBytes() * sizeof(double)) / 1048576.0 << " MB as doubles)" << endl;
     cout << endl << "Label class vector:" << d_class.t();
 }
 
@@ -204,6 +211,78 @@ void DataSet::extractMNISTimg(const string fileName, cube &tensor)
 }
 
 
+// void extractMNISTimg(const string, QuantizedMatrix&) method.
+
+/// Extracts MNIST image data from the file whose path and name is passed as a parameter, keeping the raw 8-bit pixels.
+/// Each image is unrolled row by row into a row of the matrix, as unrollCubetoMatrix() does.
+/// The scale and offset reproduce normalizeFeatures(cube&): x = (p - mid) / max.
+/// @param fileName Path and name of the file containing the image data.
+/// @param X Reference of QuantizedMatrix object to extract image data into.
+
+void DataSet::extractMNISTimg(const string fileName, QuantizedMatrix &X)
+{
+    ifstream dataFile (fileName.c_str(), ios::binary);
+    if (!dataFile.is_open())
+    {
+        cerr << "Regression: DataSet class." << endl
+             << "void extractMNISTimg(const string, QuantizedMatrix&) method." << endl
+             << "Unable to open image data file: "<< fileName
+             << endl;
+
+        exit(1);
+    }
+
+    int magic_number = 0;
+    unsigned int number_of_images = 0;
+    unsigned int n_rows = 0;
+    unsigned int n_cols = 0;
+
+    dataFile.read((char*) &magic_number, sizeof(magic_number));
+    magic_number = ReverseInt(magic_number);
+
+    dataFile.read((char*) &number_of_images, sizeof(number_of_images));
+    number_of_images = ReverseInt(number_of_images);
+
+    dataFile.read((char*) &n_rows, sizeof(n_rows));
+    n_rows = ReverseInt(n_rows);
+
+    dataFile.read((char*) &n_cols, sizeof(n_cols));
+    n_cols = ReverseInt(n_cols);
+
+    //--The file holds one image after the other, each row by row: one image per column of raw--//
+    Mat<unsigned char> raw(n_rows * n_cols, number_of_images);
+    dataFile.read((char*) raw.memptr(), raw.n_elem);
+
+    if(!raw.n_elem || dataFile.gcount() != (streamsize) raw.n_elem)
+    {
+        cerr << "Regression: DataSet class." << endl
+             << "void extractMNISTimg(const string, QuantizedMatrix&) method." << endl
+             << "Image data file: "<< fileName << " is empty or truncated."
+             << endl;
+
+        exit(1);
+    }
+
+    double min = raw.min();
+    double max = raw.max();
+    double mid = (max - min) / 2.0;
+
+    if(max <= 0.0)
+    {
+        cerr << "Regression: DataSet class." << endl
+             << "void extractMNISTimg(const string, QuantizedMatrix&) method." << endl
+             << "Image data file: "<< fileName << " cannot be all zeros."
+             << endl;
+
+        exit(1);
+    }
+
+    cout << endl << "Min: " << min << "  Max: " << max << "  Mid: " << mid << endl;
+
+    X = QuantizedMatrix(raw.t(), 1.0 / max, -mid / max);
+}
+
+
 // void extractMNISTlabel(const string, vec&) method.
 
 /// Extracts MNIST label data from the file whose path and name is passed as a parameter.
@@ -266,14 +345,78 @@ void DataSet::oneHotEncode(const vec labels, mat &oneHotMat)
         exit(0);
     }
 
+    mat indices;
+    classIndexEncode(labels, indices);
+    expandClassIndices(indices, oneHotMat);
+}
+
+
+// void classIndexEncode(const vec, mat&) const method
+
+/// Based on the labels vector y ∈ R^m, creates vector c ∈ R^m, where c⁽i⁾ is the index of y⁽i⁾ in the sorted label class vector.
+/// @param labels Vector containing instance labels.
+/// @param indices Reference of Armadillo::mat object to hold the Mx1 class indices.
+
+void DataSet::classIndexEncode(const vec labels, mat &indices) const
+{
+    if(d_class.is_empty())
+    {
+        cerr << "Regression: DataSet class." << endl
+             << "void classIndexEncode(const vec, mat&) const method." << endl
+             << "Labels class vector cannot be empty."
+             << endl;
+
+        exit(0);
+    }
+
     unsigned int instSize = labels.n_rows;
-    oneHotMat.set_size(d_class.n_rows, instSize);
-    oneHotMat.zeros();
+    indices.set_size(instSize, 1);
 
     for(unsigned int i=0; i<instSize; i++)
     {
-        uvec indx = find(d_class == labels[i], 1);
-        oneHotMat(indx[0], i) = 1.0;
+        indices(i) = classIndex(labels[i]);
+    }
+}
+
+
+// uword classIndex(const double) const method
+
+/// Binary search for a label in the sorted label class vector.
+/// @param label Instance label.
+
+uword DataSet::classIndex(const double label) const
+{
+    const double* first = d_class.memptr();
+    const double* last = first + d_class.n_elem;
+    const double* found = lower_bound(first, last, label);
+
+    if(found == last || *found != label)
+    {
+        cerr << "Regression: DataSet class." << endl
+             << "uword classIndex(const double) const method." << endl
+             << "Label: " << label << " is not in the label class vector."
+             << endl;
+
+        exit(0);
+    }
+
+    return found - first;
+}
+
+
+// void expandClassIndices(const mat&, mat&) const method
+
+/// Expands Mx1 class indices into the KxM one-hot matrix.
+/// @param indices Mx1 class indices.
+/// @param oneHotMat Reference of Armadillo::mat object to hold encoded one-hot vectors.
+
+void DataSet::expandClassIndices(const mat& indices, mat &oneHotMat) const
+{
+    oneHotMat.zeros(d_class.n_rows, indices.n_rows);
+
+    for(unsigned int i=0; i<indices.n_rows; i++)
+    {
+        oneHotMat((uword) indices(i), i) = 1.0;
     }
 }
 
@@ -300,18 +443,19 @@ void DataSet::unrollCubetoMatrix(const cube &tensor, mat &dataset)
 }
 
 
-// void extractDataFromFile(const char*, const unsigned int, const double, const double)
+// void extractDataFromFile(const char*, const unsigned int, const double, const double, const bool)
 
 /// Extracts training data containing features and target from the file whose path and name is passed as a parameter.
 /// Creates new polynomial features through feature mapping.
 /// Calculates the mean and standard deviation of the data features and then the features are Mean Normalized.
-/// Shuffels the data set and divides it into training and test sets.
+/// Shuffels the data set and divides it into training and test sets of row indices.
 /// @param fileName Path and name of the file containing the training data.
 /// @param degree Specifies the degree of polynomial for feature mapping. degree ≥ 1. degree = 1 ensures data set remains unchanged.
 /// @param trainPercent Training split of the data set > 0%.
 /// @param testPercent Test split of the data set ≥ 0%.
+/// @param stratify Splits each class of the data set at the training and test percentages.
 
-void DataSet::extractDataFromFile(const char* fileName, const unsigned int degree, const double trainPercent, const double testPercent)
+void DataSet::extractDataFromFile(const char* fileName, const unsigned int degree, const double trainPercent, const double testPercent, const bool stratify)
 {
     //--Extract no. of instances and attributes of the data set on file--//
     unsigned int instSize = instanceSize(fileName);
@@ -333,13 +477,16 @@ void DataSet::extractDataFromFile(const char* fileName, const unsigned int degre
     if(d_X.n_rows != d_y.n_rows)
     {
         cerr << "Regression: DataSet class." << endl
-             << "void extractDataFromFile(const char*, const unsigned int, const double, const double) method." << endl
+             << "void extractDataFromFile(const char*, const unsigned int, const double, const double, const bool) method." << endl
              << "No. of instances in matrix X: " << d_X.n_rows << "  and vector y: " << d_y.n_rows << " do not match."
              << endl;
 
         exit(0);
     }
 
+    //--Keep the attributes as read, for models that are served on raw instances--//
+    d_X_raw = d_X;
+
     //--Create new features through Feature Mapping--//
     d_X = mapFeatures(d_X, degree);
 
@@ -354,12 +501,18 @@ void DataSet::extractDataFromFile(const char* fileName, const unsigned int degre
     //--Normalize features--//
     d_X = normalizeFeatures(d_X);
 
+    //--Encode lables as class indices; one-hot matrices are built only on request--//
+    classIndexEncode(d_y, d_class_idx);
+
     //--Shuffle the data and segment into training and test sets--//
-    segmentDataSet(trainPercent, testPercent);
+    segmentDataSet(trainPercent, testPercent, stratify);
+
+    //--Targets are a column each, so the splits keep their own copies--//
+    d_y_train = d_y.elem(d_train_rows);
+    d_y_test = d_y.elem(d_test_rows);
 
-    //--Encode train and test lables into one-hot format--//
-    oneHotEncode(d_y_train, d_train_1hot_mat);
-    oneHotEncode(d_y_test, d_test_1hot_mat);
+    d_train_class_idx = d_class_idx.rows(d_train_rows);
+    d_test_class_idx = d_class_idx.rows(d_test_rows);
 }
 
 
@@ -552,11 +705,12 @@ void DataSet::extractY(const char* const fileName, const unsigned int M, const u
 }
 
 
-// mat X(void) const method
+// const mat& X(void) const method
 
-/// Returns a matrix containing the attributes of the data set.
+/// Returns reference to the matrix containing the attributes of the data set, mapped and normalized.
+/// The training and test sets are the rows trainRows() and testRows() of it.
 
-mat DataSet::X(void) const
+const mat& DataSet::X(void) const
 {
     return d_X;
 }
@@ -572,6 +726,29 @@ vec DataSet::y(void) const
 }
 
 
+// const mat& rawX(void) const method
+
+/// Returns reference to a matrix containing the instances of the data set as read from file, before feature mapping and normalization.
+/// Empty for MNIST, whose raw pixels are the values of XTrainQuantized() and XTestQuantized().
+
+const mat& DataSet::rawX(void) const
+{
+    return d_X_raw;
+}
+
+
+// const mat& classIndices(void) const method
+
+/// Returns reference to a matrix of size Mx1, containing the class indices of the targets of the whole data set.
+/// Indexed like X(), so that trainRows() and testRows() select the targets of the training and test sets.
+/// Empty for MNIST.
+
+const mat& DataSet::classIndices(void) const
+{
+    return d_class_idx;
+}
+
+
 // vec labels(void) const method
 
 /// Returns a vector containing the k distinct labels of the data set.
@@ -598,7 +775,7 @@ unsigned int DataSet::M(void) const
 
 unsigned int DataSet::N(void) const
 {
-    return d_X_train.n_cols;
+    return d_X_train_q.is_empty() ? d_X.n_cols : d_X_train_q.N();
 }
 
 
@@ -612,16 +789,47 @@ unsigned int DataSet::K(void) const
 }
 
 
+// unsigned int degree(void) const method
+
+/// Returns the degree of polynomial used for feature mapping.
+
+unsigned int DataSet::degree(void) const
+{
+    return d_degree;
+}
+
+
 // mat& XTrain(void) method
 
 /// Returns reference to a matrix containing the instances of the training set.
+/// The matrix is gathered from the rows trainRows() of X(), or dequantized for 8-bit data sets, on first use.
+/// Training can read X() through trainRows() instead, without the copy.
 
 mat& DataSet::XTrain(void)
 {
+    if(d_X_train.is_empty() && !d_X_train_q.is_empty())
+    {
+        d_X_train = d_X_train_q.dequantize();
+    }
+    else if(d_X_train.is_empty() && !d_train_rows.is_empty())
+    {
+        d_X_train = d_X.rows(d_train_rows);
+    }
+
     return d_X_train;
 }
 
 
+// const QuantizedMatrix& XTrainQuantized(void) const method
+
+/// Returns reference to the 8-bit instances of the training set. Empty unless the data set is MNIST.
+
+const QuantizedMatrix& DataSet::XTrainQuantized(void) const
+{
+    return d_X_train_q;
+}
+
+
 // mat& YTrain(void) method
 
 /// Returns reference to a matrix of size Mx1, containing targets of the training set.
@@ -635,33 +843,79 @@ mat& DataSet::yTrain(void)
 // mat& Train_oneHotMatrix(void) method
 
 /// Returns reference to a matrix containing targets of the training set, in the form of one-hot vector format.
+/// The matrix is expanded from the class indices on first use.
 
 mat& DataSet::Train_oneHotMatrix(void)
 {
+    if(d_train_1hot_mat.is_empty())
+    {
+        expandClassIndices(d_train_class_idx, d_train_1hot_mat);
+    }
+
     return d_train_1hot_mat;
 }
 
 
+// mat& Train_classIndices(void) method
+
+/// Returns reference to a matrix of size Mx1, containing the class indices of the training set targets.
+
+mat& DataSet::Train_classIndices(void)
+{
+    return d_train_class_idx;
+}
+
+
+// const uvec& trainRows(void) const method
+
+/// Returns reference to the ascending indices of the rows of X() that make up the training set. Empty for MNIST.
+
+const uvec& DataSet::trainRows(void) const
+{
+    return d_train_rows;
+}
+
+
 // unsigned int trainingSize(void) const method
 
 /// Returns the training data size.
 
 unsigned int DataSet::trainingSize(void) const
 {
-    return d_X_train.n_rows;
+    return d_X_train_q.is_empty() ? d_train_rows.n_rows : d_X_train_q.M();
 }
 
 
 // mat& XTest(void) method
 
 /// Returns reference to a matrix containing instances of the test set.
+/// The matrix is gathered from the rows testRows() of X(), or dequantized for 8-bit data sets, on first use.
 
 mat& DataSet::XTest(void)
 {
+    if(d_X_test.is_empty() && !d_X_test_q.is_empty())
+    {
+        d_X_test = d_X_test_q.dequantize();
+    }
+    else if(d_X_test.is_empty() && !d_test_rows.is_empty())
+    {
+        d_X_test = d_X.rows(d_test_rows);
+    }
+
     return d_X_test;
 }
 
 
+// const QuantizedMatrix& XTestQuantized(void) const method
+
+/// Returns reference to the 8-bit instances of the test set. Empty unless the data set is MNIST.
+
+const QuantizedMatrix& DataSet::XTestQuantized(void) const
+{
+    return d_X_test_q;
+}
+
+
 // mat& YTest(void) method
 
 /// Returns reference to a matrix of size Mx1, containing targest of the test set.
@@ -675,20 +929,46 @@ mat& DataSet::yTest(void)
 // mat& Test_oneHotMatrix(void) method
 
 /// Returns reference to a matrix containing targets of the test set, in the form of one-hot vector format.
+/// The matrix is expanded from the class indices on first use.
 
 mat& DataSet::Test_oneHotMatrix(void)
 {
+    if(d_test_1hot_mat.is_empty())
+    {
+        expandClassIndices(d_test_class_idx, d_test_1hot_mat);
+    }
+
     return d_test_1hot_mat;
 }
 
 
+// mat& Test_classIndices(void) method
+
+/// Returns reference to a matrix of size Mx1, containing the class indices of the test set targets.
+
+mat& DataSet::Test_classIndices(void)
+{
+    return d_test_class_idx;
+}
+
+
+// const uvec& testRows(void) const method
+
+/// Returns reference to the ascending indices of the rows of X() that make up the test set. Empty for MNIST.
+
+const uvec& DataSet::testRows(void) const
+{
+    return d_test_rows;
+}
+
+
 // unsigned int testSize(void) const method
 
 /// Returns the test data size.
 
 unsigned int DataSet::testSize(void) const
 {
-    return d_X_test.n_rows;
+    return d_X_test_q.is_empty() ? d_test_rows.n_rows : d_X_test_q.M();
 }
 
 
@@ -939,18 +1219,36 @@ mat DataSet::mapFeatures(const mat X, const unsigned int degree) const
 }
 
 
-// void segmentDataSet(const double, const double) const method
+// mat featureExponents(void) const method
 
-/// Shuffels the data set and divides it into training and test sets.
+/// Returns the exponents of the features of the data set, one row per feature and one column per raw attribute,
+/// such that feature f = ∏_c x_c^E(f,c). MNIST pixels are not mapped, so each feature is its own pixel.
+
+mat DataSet::featureExponents(void) const
+{
+    if(!d_X_train_q.is_empty())
+    {
+        return eye<mat>(d_X_train_q.N(), d_X_train_q.N());
+    }
+
+    return exponents(d_X_raw, d_degree);
+}
+
+
+// void segmentDataSet(const double, const double, const bool) method
+
+/// Shuffels the data set and divides it into training and test sets, kept as indices of the rows of X() instead of copies.
+/// The indices of each set are in ascending order, so that the rows gathered through them are read front to back.
 /// @param trainPercent Training split of the data set > 0%.
 /// @param testPercent Test split of the data set ≥ 0%.
+/// @param stratify Splits each class at the training and test percentages, so that both sets keep the class proportions.
 
-void DataSet::segmentDataSet(const double trainPercent, const double testPercent)
+void DataSet::segmentDataSet(const double trainPercent, const double testPercent, const bool stratify)
 {
     if(!(trainPercent >= 0.0 && trainPercent <= 100.0) || !(testPercent >= 0.0 && testPercent <= 100.0))
     {
         cerr << "Regression: DataSet class." << endl
-             << "void segmentDataSet(const double, const double) method" << endl
+             << "void segmentDataSet(const double, const double, const bool) method" << endl
              << "Training size(%): " << trainPercent << " and Test size(%): " << testPercent << " should both be in the range [0,100]."
              << endl;
 
@@ -960,7 +1258,7 @@ void DataSet::segmentDataSet(const double trainPercent, const double testPercent
     if(trainPercent + testPercent != 100.0)
     {
         cerr << "Regression: DataSet class." << endl
-             << "void segmentDataSet(const double, const double) method" << endl
+             << "void segmentDataSet(const double, const double, const bool) method" << endl
              << "Training set: " << trainPercent << " + Test set: " << testPercent << " != 100%"
              << endl;
 
@@ -968,53 +1266,67 @@ void DataSet::segmentDataSet(const double trainPercent, const double testPercent
     }
 
     unsigned int m = d_X.n_rows;
-    unsigned int n = d_X.n_cols;
 
-    //--Combine matrix X and vector y by inserting vector y as the last column of matrix X--//
-    mat Xy = d_X;
-    Xy.insert_cols(n, d_y);
+    if(stratify && d_class_idx.n_rows != m)
+    {
+        cerr << "Regression: DataSet class." << endl
+             << "void segmentDataSet(const double, const double, const bool) method" << endl
+             << "Class indices: " << d_class_idx.n_rows << " must be encoded for each of the " << m << " instances to stratify."
+             << endl;
 
-    //--Shuffle the whole data set--//
-    Xy = shuffle(Xy);
+        exit(1);
+    }
 
-    //--Calculate training set and test set size--//
-    unsigned int trainSize = m * (trainPercent/100.0);
-    unsigned int testSize = m - trainSize;
+    //--Shuffle the row indices of the whole data set--//
+    uvec order = randperm(m);
 
-    //--Segregate data into training and test sets--//
-    if(trainSize)
+    //--Stratification groups the shuffled rows by class, keeping their shuffled order within each class--//
+    if(stratify)
     {
-        d_X_train = Xy;
-        d_X_train.shed_rows(trainSize, m-1);
-
-        d_y_train = d_X_train.col(n);
-        d_X_train.shed_col(n);
+        uvec grouped = order.elem(stable_sort_index(d_class_idx.elem(order)));
+        order = grouped;
     }
 
-    if(testSize)
+    //--The leading trainPercent of each group goes to the training set; unstratified, the data set is one group--//
+    uvec training = zeros<uvec>(m);
+    unsigned int first = 0;
+
+    while(first < m)
     {
-        d_X_test = Xy;
-        if(trainSize)
+        unsigned int last = stratify ? first : m-1;
+        while(last+1 < m && d_class_idx(order(last+1)) == d_class_idx(order(first)))
         {
-            d_X_test.shed_rows(0, trainSize-1);
+            last++;
         }
 
-        d_y_test = d_X_test.col(n);
-        d_X_test.shed_col(n);
+        unsigned int trainSize = (last - first + 1) * (trainPercent/100.0);
+        for(unsigned int j=first; j<first+trainSize; j++)
+        {
+            training(order(j)) = 1;
+        }
+
+        first = last + 1;
     }
 
-    if(d_X_train.n_rows + d_X_test.n_rows != m)
+    d_train_rows = find(training);
+    d_test_rows = find(training == 0);
+
+    //--Dense copies of a previous split are stale--//
+    d_X_train.reset();
+    d_X_test.reset();
+
+    if(d_train_rows.n_rows + d_test_rows.n_rows != m)
     {
         cerr << "Regression: DataSet class." << endl
-             << "void segmentDataSet(const double, const double) method" << endl
-             << "Training set: " << d_X_train.n_rows << " + Test set: " << d_X_train.n_rows << " != Data size: " << m
+             << "void segmentDataSet(const double, const double, const bool) method" << endl
+             << "Training set: " << d_train_rows.n_rows << " + Test set: " << d_test_rows.n_rows << " != Data size: " << m
              << endl;
 
         exit(1);
     }
 
-    cout << endl << "Training set size: " << d_X_train.n_rows
-         << endl << "Test set size: " << d_X_test.n_rows << endl;
+    cout << endl << "Training set size: " << d_train_rows.n_rows
+         << endl << "Test set size: " << d_test_rows.n_rows << endl;
 }
 
 
@@ -1040,7 +1352,7 @@ void DataSet::printDataSet(void) const
 void DataSet::printTrainingSet(void) const
 {
     //--Combine matrix XTrain and vector yTrain by inserting vector yTrain as the last column of XTrain--//
-    mat Xy = d_X_train;
+    mat Xy = d_X.rows(d_train_rows);
     Xy.insert_cols(Xy.n_cols, d_y_train);
 
     cout << endl << "Training set:" << endl;
@@ -1055,7 +1367,7 @@ void DataSet::printTrainingSet(void) const
 void DataSet::printTestSet(void) const
 {
     //--Combine matrix XTest and vector yTest by inserting vector yTest as the last column of XTest--//
-    mat Xy = d_X_test;
+    mat Xy = d_X.rows(d_test_rows);
     Xy.insert_cols(Xy.n_cols, d_y_test);
 
     cout << endl << "Test set:" << endl;
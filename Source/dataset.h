@@ -21,6 +21,7 @@
 #include<math.h>
 
 #include "armadillo"
+#include "quantized_matrix.h"
 
 using namespace std;
 using namespace arma;
@@ -28,15 +29,17 @@ using namespace arma;
 class DataSet
 {
 public:
-    DataSet(const char*, const unsigned int, const double, const double, const bool);
+    DataSet(const char*, const unsigned int, const double, const double, const bool, const bool);
 
     void extractMNISTData(const string);
-    void extractDataFromFile(const char*, const unsigned int, const double, const double);
+    void extractDataFromFile(const char*, const unsigned int, const double, const double, const bool);
 
     int ReverseInt(int);
     void extractMNISTimg(const string, cube&);
+    void extractMNISTimg(const string, QuantizedMatrix&);
     void extractMNISTlabel(const string, vec&);
     void oneHotEncode(const vec, mat&);
+    void classIndexEncode(const vec, mat&) const;
     void unrollCubetoMatrix(const cube&, mat&);
 
     unsigned int instanceSize(const char* const) const;
@@ -45,22 +48,31 @@ public:
     void extractX(const char* const, const unsigned int, const unsigned int);
     void extractY(const char* const, const unsigned int, const unsigned int);    
 
-    mat X() const;
+    const mat& X() const;
+    const mat& rawX() const;
     vec y() const;
     vec labels() const;
+    const mat& classIndices() const;
 
     unsigned int M() const;
     unsigned int N() const;
     unsigned int K() const;
+    unsigned int degree() const;
 
     mat& XTrain();
+    const QuantizedMatrix& XTrainQuantized() const;
     mat& yTrain();
     mat& Train_oneHotMatrix();
+    mat& Train_classIndices();
+    const uvec& trainRows() const;
     unsigned int trainingSize(void) const;
 
     mat& XTest();
+    const QuantizedMatrix& XTestQuantized() const;
     mat& yTest();
     mat& Test_oneHotMatrix();
+    mat& Test_classIndices();
+    const uvec& testRows() const;
     unsigned int testSize(void) const;
 
     vec Mean() const;
@@ -73,8 +85,9 @@ public:
 
     mat exponents(const mat, const unsigned int) const;
     mat mapFeatures(const mat, const unsigned int) const;
+    mat featureExponents(void) const;
 
-    void segmentDataSet(const double, const double);
+    void segmentDataSet(const double, const double, const bool);
 
     void printDataSet() const;
     void printTrainingSet() const;
@@ -82,24 +95,40 @@ public:
 
     void saveToFile(const mat) const;
 
+private:
+    uword classIndex(const double) const;
+    void expandClassIndices(const mat&, mat&) const;
+
 private:
     mat d_X;
     vec d_y;
 
+    mat d_X_raw;
+    unsigned int d_degree;
+
+    mat d_class_idx;
+
+    //--Splits are ascending row indices into d_X; d_X_train and d_X_test are only filled on request--//
+    uvec d_train_rows;
+    uvec d_test_rows;
+
     mat d_X_train;
     vec d_y_train;
 
     mat d_X_test;
     vec d_y_test;
 
-    cube d_train_img_cube;
+    QuantizedMatrix d_X_train_q;
     vec d_train_label_vec;
     mat d_train_1hot_mat;
 
-    cube d_test_img_cube;
+    QuantizedMatrix d_X_test_q;
     vec d_test_label_vec;
     mat d_test_1hot_mat;
 
+    mat d_train_class_idx;
+    mat d_test_class_idx;
+
     vec d_class;
 
     vec d_mu;
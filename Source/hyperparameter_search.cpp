@@ -0,0 +1,443 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   H Y P E R P A R A M E T E R   S E A R C H   C L A S S                                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "hyperparameter_search.h"
+#include "linear_regression.h"
+#include "logistic_regression.h"
+
+#include<algorithm>
+#include<chrono>
+#include<cmath>
+
+//--Diverged configurations (NaN or infinite cost) rank behind every finite one--//
+static bool lowerCost(const HyperparameterConfig& a, const HyperparameterConfig& b)
+{
+    bool a_finite = std::isfinite(a.validation_cost);
+    bool b_finite = std::isfinite(b.validation_cost);
+
+    if(a_finite != b_finite)
+    {
+        return a_finite;
+    }
+
+    return a_finite && a.validation_cost < b.validation_cost;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a search over a data set loaded once with polynomial degree 1.
+/// Higher degrees are mapped from its normalized training features and cached per degree.
+/// The training set is split once into search-train and search-validation row views.
+/// @param ds Data set loaded with degree 1.
+/// @param type Model type: "Regression" or "Classification".
+
+HyperparameterSearch::HyperparameterSearch(DataSet& ds, const char* type):d_dset(ds)
+{
+    if(strcmp(type, "Regression") && strcmp(type, "Classification"))
+    {
+        cerr << "Regression: HyperparameterSearch class." << endl
+             << "HyperparameterSearch(DataSet&, const char*) constructor." << endl
+             << "Unknown model type: " << type << ". Expected Regression or Classification."
+             << endl;
+
+        exit(1);
+    }
+
+    unsigned int m = ds.trainingSize();
+    unsigned int m_val = (m * SEARCH_VALIDATION_PERCENT) / 100;
+
+    if(!m_val || m_val == m)
+    {
+        cerr << "Regression: HyperparameterSearch class." << endl
+             << "HyperparameterSearch(DataSet&, const char*) constructor." << endl
+             << "Training set of size: " << m << " is too small to hold out a validation split."
+             << endl;
+
+        exit(1);
+    }
+
+    d_type = type;
+    d_rng.seed(rand());
+
+    //--Sorted row indices keep the tile gathers of both views in memory order--//
+    uvec order = randperm(m);
+    d_validation_rows = sort(order.head(m_val));
+    d_train_rows = sort(order.tail(m - m_val));
+}
+
+
+// void gridSearch(const vec&, const vec&, const uvec&) method
+
+/// Replaces the candidate configurations with the cartesian product of the given values.
+/// @param alphas Learning rates > 0.
+/// @param lamdas Regularization parameters >= 0.
+/// @param degrees Polynomial degrees >= 1.
+
+void HyperparameterSearch::gridSearch(const vec& alphas, const vec& lamdas, const uvec& degrees)
+{
+    if(!alphas.n_elem || !lamdas.n_elem || !degrees.n_elem)
+    {
+        cerr << "Regression: HyperparameterSearch class." << endl
+             << "void gridSearch(const vec&, const vec&, const uvec&) method." << endl
+             << "Alpha, Lamda and Degree grids cannot be empty."
+             << endl;
+
+        exit(1);
+    }
+
+    d_configs.clear();
+
+    for(unsigned int d=0; d<degrees.n_elem; d++)
+    {
+        for(unsigned int a=0; a<alphas.n_elem; a++)
+        {
+            for(unsigned int l=0; l<lamdas.n_elem; l++)
+            {
+                HyperparameterConfig config;
+
+                config.alpha = alphas(a);
+                config.lamda = lamdas(l);
+                config.degree = degrees(d);
+                config.validation_cost = datum::inf;
+                config.iterations = 0;
+                config.converged = false;
+
+                d_configs.push_back(config);
+            }
+        }
+    }
+}
+
+
+// void randomSearch(const vec&, const vec&, const uvec&, const unsigned int) method
+
+/// Replaces the candidate configurations with random samples of the search space.
+/// Alpha is drawn log-uniformly; Lamda log-uniformly, or uniformly when its lower bound is 0.
+/// @param alpha_range Alpha bounds [min, max], min > 0.
+/// @param lamda_range Lamda bounds [min, max], min >= 0.
+/// @param degrees Candidate polynomial degrees, drawn uniformly.
+/// @param samples Number of configurations > 0.
+
+void HyperparameterSearch::randomSearch(const vec& alpha_range, const vec& lamda_range, const uvec& degrees, const unsigned int samples)
+{
+    if(alpha_range.n_elem != 2 || lamda_range.n_elem != 2 || !degrees.n_elem || !samples)
+    {
+        cerr << "Regression: HyperparameterSearch class." << endl
+             << "void randomSearch(const vec&, const vec&, const uvec&, const unsigned int) method." << endl
+             << "Alpha and Lamda ranges need 2 bounds, and Degrees and samples cannot be empty."
+             << endl;
+
+        exit(1);
+    }
+
+    if(alpha_range(0) <= 0 || alpha_range(1) < alpha_range(0) || lamda_range(0) < 0 || lamda_range(1) < lamda_range(0))
+    {
+        cerr << "Regression: HyperparameterSearch class." << endl
+             << "void randomSearch(const vec&, const vec&, const uvec&, const unsigned int) method." << endl
+             << "Invalid ranges. Alpha: [" << alpha_range(0) << "," << alpha_range(1) << "]"
+             << " Lamda: [" << lamda_range(0) << "," << lamda_range(1) << "]"
+             << endl;
+
+        exit(1);
+    }
+
+    uniform_real_distribution<double> log_alpha(log(alpha_range(0)), log(alpha_range(1)));
+    uniform_real_distribution<double> lin_lamda(lamda_range(0), lamda_range(1));
+    uniform_real_distribution<double> log_lamda(log(lamda_range(0) > 0 ? lamda_range(0) : 1.0), log(lamda_range(1) > 0 ? lamda_range(1) : 1.0));
+    uniform_int_distribution<unsigned int> degree(0, degrees.n_elem - 1);
+
+    d_configs.clear();
+
+    for(unsigned int s=0; s<samples; s++)
+    {
+        HyperparameterConfig config;
+
+        config.alpha = exp(log_alpha(d_rng));
+        config.lamda = (lamda_range(0) > 0) ? exp(log_lamda(d_rng)) : lin_lamda(d_rng);
+        config.degree = degrees(degree(d_rng));
+        config.validation_cost = datum::inf;
+        config.iterations = 0;
+        config.converged = false;
+
+        d_configs.push_back(config);
+    }
+}
+
+
+// HyperparameterConfig run(const double, const unsigned int, const unsigned int, const unsigned int, const unsigned int) method
+
+/// Trains the candidate configurations concurrently with successive halving.
+/// Every surviving configuration is trained up to the rung budget and scored on the validation split;
+/// only the best 1/eta go on to a budget eta times larger, and the last survivor is trained to max_iter.
+/// @param delta Convergence threshold on the change in cost.
+/// @param min_iter Iteration budget of the first rung > 0.
+/// @param max_iter Iteration budget of the final rung >= min_iter.
+/// @param eta Reduction factor between rungs >= 2.
+/// @param threads Number of worker threads > 0.
+
+HyperparameterConfig HyperparameterSearch::run(const double delta, const unsigned int min_iter, const unsigned int max_iter, const unsigned int eta, const unsigned int threads)
+{
+    if(d_configs.empty())
+    {
+        cerr << "Regression: HyperparameterSearch class." << endl
+             << "HyperparameterConfig run(const double, const unsigned int, const unsigned int, const unsigned int, const unsigned int) method." << endl
+             << "No configurations to search. Call gridSearch() or randomSearch() first."
+             << endl;
+
+        exit(1);
+    }
+
+    if(!min_iter || max_iter < min_iter || eta < 2)
+    {
+        cerr << "Regression: HyperparameterSearch class." << endl
+             << "HyperparameterConfig run(const double, const unsigned int, const unsigned int, const unsigned int, const unsigned int) method." << endl
+             << "Invalid budgets. Min iterations: " << min_iter << " Max iterations: " << max_iter << " Eta: " << eta
+             << endl;
+
+        exit(1);
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    cacheFeatures();
+
+    const mat& Y = (d_type == "Classification") ? d_dset.Train_classIndices() : d_dset.yTrain();
+    unsigned int outputs = (d_type == "Classification") ? d_dset.K() : 1;
+    DataView::Labels labels = (d_type == "Classification") ? DataView::ClassIndices : DataView::Targets;
+    unsigned int c = d_configs.size();
+
+    //--Every configuration owns its model (for Alpha and Lamda) and its Ө; the mapped features are shared--//
+    vector<Regression*> models(c);
+    vector<mat> theta(c);
+
+    for(unsigned int i=0; i<c; i++)
+    {
+        models[i] = createModel(d_configs[i]);
+        theta[i] = zeros<mat>(features(d_configs[i].degree).n_cols + 1, outputs);
+        d_configs[i].iterations = 0;
+        d_configs[i].validation_cost = datum::inf;
+        d_configs[i].converged = false;
+    }
+
+    vector<unsigned int> alive(c);
+    for(unsigned int i=0; i<c; i++)
+    {
+        alive[i] = i;
+    }
+
+    ThreadPool pool(threads);
+    unsigned int budget = min_iter;
+
+    cout << endl << "Successive halving over " << c << " configurations (eta: " << eta << ")"
+         << endl << "#Rung  #Configurations  #Iterations  #Best_J_val(Theta)" << endl;
+
+    for(unsigned int rung=0; ; rung++)
+    {
+        for(unsigned int a=0; a<alive.size(); a++)
+        {
+            unsigned int i = alive[a];
+
+            pool.enqueue([this, &Y, labels, &models, &theta, i, budget, delta]()
+            {
+                HyperparameterConfig& config = d_configs[i];
+                const mat& X = features(config.degree);
+
+                DataView train(X, Y, labels, d_train_rows);
+                DataView validation(X, Y, labels, d_validation_rows);
+
+                //--Warm-continue from the previous rung; a converged configuration needs no more iterations--//
+                if(!config.converged && config.iterations < budget)
+                {
+                    unsigned int requested = budget - config.iterations;
+                    unsigned int it = 0;
+
+                    models[i]->fit(train, theta[i], delta, requested, it);
+
+                    config.iterations += it;
+                    config.converged = (it < requested);
+                }
+
+                double f1;
+                models[i]->evaluate(validation, theta[i], config.validation_cost, f1);
+            });
+        }
+
+        pool.wait();
+
+        stable_sort(alive.begin(), alive.end(), [this](const unsigned int a, const unsigned int b)
+        {
+            return lowerCost(d_configs[a], d_configs[b]);
+        });
+
+        cout << rung << "  " << alive.size() << "  " << budget << "  " << d_configs[alive[0]].validation_cost << endl;
+
+        if(budget >= max_iter)
+        {
+            break;
+        }
+
+        //--Keep the best 1/eta; the last survivor skips straight to the full budget--//
+        unsigned int keep = alive.size() / eta;
+        alive.resize(keep ? keep : 1);
+
+        budget = (alive.size() == 1 || budget * eta > max_iter) ? max_iter : budget * eta;
+    }
+
+    HyperparameterConfig best = d_configs[alive[0]];
+
+    for(unsigned int i=0; i<c; i++)
+    {
+        delete models[i];
+    }
+
+    //--Compute is counted in gradient descent iterations, against running every configuration to max_iter--//
+    unsigned long long used = 0;
+    for(unsigned int i=0; i<c; i++)
+    {
+        used += d_configs[i].iterations;
+    }
+
+    unsigned long long exhaustive = (unsigned long long) c * max_iter;
+    double search_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<HyperparameterConfig> ranked = d_configs;
+    stable_sort(ranked.begin(), ranked.end(), lowerCost);
+
+    cout << endl << "Finished hyperparameter search in " << search_time << "s. Configurations by validation cost:"
+         << endl << "#Alpha  #Lamda  #Degree  #Iterations  #J_val(Theta)" << endl;
+
+    for(unsigned int i=0; i<c; i++)
+    {
+        cout << ranked[i].alpha << "  " << ranked[i].lamda << "  " << ranked[i].degree << "  "
+             << ranked[i].iterations << "  " << ranked[i].validation_cost << endl;
+    }
+
+    cout << "Best configuration: Alpha: " << best.alpha << " Lamda: " << best.lamda << " Degree: " << best.degree
+         << " J_val(Theta): " << best.validation_cost << endl
+         << "Compute: " << used << " of " << exhaustive << " iterations ("
+         << (100.0 * (exhaustive - used)) / exhaustive << "% saved)" << endl;
+
+    return best;
+}
+
+
+// unsigned int configurations(void) const method
+
+/// Returns the number of candidate configurations.
+
+unsigned int HyperparameterSearch::configurations(void) const
+{
+    return d_configs.size();
+}
+
+
+// const mat& features(const unsigned int) const method
+
+/// Returns the training features mapped to the given polynomial degree.
+/// Degree 1 is the data set's own training matrix; higher degrees must have been cached by run().
+/// @param degree Polynomial degree >= 1.
+
+const mat& HyperparameterSearch::features(const unsigned int degree) const
+{
+    if(degree == 1)
+    {
+        return d_dset.XTrain();
+    }
+
+    map<unsigned int, mat>::const_iterator f = d_features.find(degree);
+
+    if(f == d_features.end())
+    {
+        cerr << "Regression: HyperparameterSearch class." << endl
+             << "const mat& features(const unsigned int) const method." << endl
+             << "Features of degree: " << degree << " have not been mapped."
+             << endl;
+
+        exit(1);
+    }
+
+    return f->second;
+}
+
+
+// void cacheFeatures(void) method
+
+/// Maps the training features once per distinct degree among the configurations.
+/// Each mapped column is rescaled to zero mean and unit variance, as the data set does for its own degree.
+
+void HyperparameterSearch::cacheFeatures(void)
+{
+    for(unsigned int i=0; i<d_configs.size(); i++)
+    {
+        unsigned int degree = d_configs[i].degree;
+
+        if(degree == 0)
+        {
+            cerr << "Regression: HyperparameterSearch class." << endl
+                 << "void cacheFeatures(void) method." << endl
+                 << "Degree: " << degree << " of configuration: " << i << " has to be >= 1."
+                 << endl;
+
+            exit(1);
+        }
+
+        if(degree == 1 || d_features.count(degree))
+        {
+            continue;
+        }
+
+        mat X = d_dset.mapFeatures(d_dset.XTrain(), degree);
+
+        for(unsigned int j=0; j<X.n_cols; j++)
+        {
+            double mu = mean(X.col(j));
+            double sigma = stddev(X.col(j));
+
+            X.col(j) -= mu;
+            if(sigma > 0)
+            {
+                X.col(j) /= sigma;
+            }
+        }
+
+        d_features[degree] = X;
+    }
+}
+
+
+// Regression* createModel(const HyperparameterConfig&) const method
+
+/// Creates a model of the search type with the configuration's Alpha and Lamda.
+/// @param config Hyperparameter configuration.
+
+Regression* HyperparameterSearch::createModel(const HyperparameterConfig& config) const
+{
+    Regression* model;
+
+    if(d_type == "Classification")
+    {
+        model = new LogisticRegression(d_dset);
+    }
+    else
+    {
+        model = new LinearRegression(d_dset);
+    }
+
+    model->set_alpha(config.alpha);
+    model->set_lamda(config.lamda);
+
+    return model;
+}
@@ -0,0 +1,77 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   H Y P E R P A R A M E T E R   S E A R C H   C L A S S   H E A D E R                    */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef HYPERPARAMETER_SEARCH_H
+#define HYPERPARAMETER_SEARCH_H
+
+#include<iostream>
+#include<string>
+#include<vector>
+#include<map>
+#include<random>
+
+#include "armadillo"
+#include "dataset.h"
+#include "data_view.h"
+#include "thread_pool.h"
+#include "regression.h"
+
+using namespace std;
+using namespace arma;
+
+#define SEARCH_VALIDATION_PERCENT 20
+
+struct HyperparameterConfig
+{
+    double alpha;
+    double lamda;
+    unsigned int degree;
+
+    double validation_cost;
+    unsigned int iterations;
+    bool converged;             //--Stopped on delta before its budget; written only by the task that trains it--//
+};
+
+class HyperparameterSearch
+{
+public:
+    HyperparameterSearch(DataSet&, const char*);
+
+    void gridSearch(const vec&, const vec&, const uvec&);
+    void randomSearch(const vec&, const vec&, const uvec&, const unsigned int);
+
+    HyperparameterConfig run(const double, const unsigned int, const unsigned int, const unsigned int, const unsigned int);
+
+    unsigned int configurations(void) const;
+    const mat& features(const unsigned int) const;
+
+private:
+    void cacheFeatures(void);
+    Regression* createModel(const HyperparameterConfig&) const;
+
+private:
+    DataSet& d_dset;
+    string d_type;
+
+    vector<HyperparameterConfig> d_configs;
+    map<unsigned int, mat> d_features;
+
+    uvec d_train_rows;
+    uvec d_validation_rows;
+
+    mt19937 d_rng;
+};
+
+#endif // HYPERPARAMETER_SEARCH_H
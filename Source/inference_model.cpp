@@ -0,0 +1,303 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   I N F E R E N C E   M O D E L   C L A S S                                              */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "inference_model.h"
+
+#include<stdlib.h>
+#include<string.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+//--A section must lie inside the image and start on a cache line--//
+static bool validSection(const uint64_t offset, const uint64_t bytes, const uint64_t image)
+{
+    return (offset % MODEL_FILE_ALIGNMENT == 0) && offset <= image && bytes <= image - offset;
+}
+
+//--Returns the reason the image is not a model file this build can serve, or NULL--//
+static const char* invalidImage(const void* image, const size_t bytes)
+{
+    const ModelFileHeader* h = (const ModelFileHeader*) image;
+
+    if(bytes < sizeof(ModelFileHeader) || memcmp(h->magic, MODEL_FILE_MAGIC, sizeof(h->magic)))
+    {
+        return "Not a model file.";
+    }
+
+    if(h->byte_order != MODEL_FILE_BYTE_ORDER)
+    {
+        return "Model file was written on a host of a different byte order.";
+    }
+
+    if(h->version != MODEL_FILE_VERSION)
+    {
+        return "Unsupported model file version.";
+    }
+
+    if(h->bytes != bytes)
+    {
+        return "Model file is truncated.";
+    }
+
+    if(!h->classes || h->link > ModelSoftmax)
+    {
+        return "Model file header is corrupt.";
+    }
+
+    if(!validSection(h->mu, (uint64_t) h->features * sizeof(double), bytes) ||
+       !validSection(h->inv_sigma, (uint64_t) h->features * sizeof(double), bytes) ||
+       !validSection(h->theta, (uint64_t) (h->features + 1) * h->classes * sizeof(double), bytes) ||
+       !validSection(h->plan_offset, ((uint64_t) h->features + 1) * sizeof(uint32_t), bytes) ||
+       !validSection(h->plan_attribute, (uint64_t) h->terms * sizeof(uint32_t), bytes) ||
+       !validSection(h->plan_power, (uint64_t) h->terms * sizeof(uint32_t), bytes) ||
+       !validSection(h->label, (uint64_t) h->labels * sizeof(double), bytes))
+    {
+        return "Model file sections are out of bounds.";
+    }
+
+    //--The plan is followed blindly on every call, so it is checked once here--//
+    const uint32_t* offset = (const uint32_t*) ((const char*) image + h->plan_offset);
+    const uint32_t* attribute = (const uint32_t*) ((const char*) image + h->plan_attribute);
+
+    for(uint32_t f=0; f<h->features; f++)
+    {
+        if(offset[f] > offset[f+1])
+        {
+            return "Model file exponent plan is corrupt.";
+        }
+    }
+
+    if(offset[h->features] != h->terms)
+    {
+        return "Model file exponent plan is corrupt.";
+    }
+
+    for(uint32_t t=0; t<h->terms; t++)
+    {
+        if(attribute[t] >= h->attributes)
+        {
+            return "Model file exponent plan is corrupt.";
+        }
+    }
+
+    return NULL;
+}
+
+
+// CONSTRUCTOR
+
+/// Maps a model file written by Predictor::save() read-only into memory. Its pages are shared with every
+/// other process serving the same file, and are read in from disk on first use.
+/// @param fileName Path of the model file.
+
+InferenceModel::InferenceModel(const string& fileName)
+{
+    int fd = open(fileName.c_str(), O_RDONLY);
+    struct stat st;
+
+    if(fd < 0 || fstat(fd, &st) || st.st_size <= 0)
+    {
+        cerr << "Regression: InferenceModel class." << endl
+             << "InferenceModel(const string&) constructor." << endl
+             << "Cannot open model file: " << fileName
+             << endl;
+
+        exit(1);
+    }
+
+    d_bytes = st.st_size;
+    d_image = mmap(NULL, d_bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(d_image == MAP_FAILED)
+    {
+        cerr << "Regression: InferenceModel class." << endl
+             << "InferenceModel(const string&) constructor." << endl
+             << "Cannot map model file: " << fileName
+             << endl;
+
+        exit(1);
+    }
+
+    const char* reason = invalidImage(d_image, d_bytes);
+
+    if(reason != NULL)
+    {
+        cerr << "Regression: InferenceModel class." << endl
+             << "InferenceModel(const string&) constructor." << endl
+             << reason << " File: " << fileName
+             << endl;
+
+        exit(1);
+    }
+
+    d_header = (const ModelFileHeader*) d_image;
+    d_model = frozenModel(d_image);
+}
+
+
+// DESTRUCTOR
+
+/// Unmaps the model file.
+
+InferenceModel::~InferenceModel()
+{
+    munmap(d_image, d_bytes);
+}
+
+
+// unsigned int N(void) const method
+
+/// Returns the number of raw attributes of an instance.
+
+unsigned int InferenceModel::N(void) const
+{
+    return d_model.attributes;
+}
+
+
+// unsigned int K(void) const method
+
+/// Returns the number of outputs of a prediction.
+
+unsigned int InferenceModel::K(void) const
+{
+    return d_model.classes;
+}
+
+
+// unsigned int features(void) const method
+
+/// Returns the number of features an instance is mapped to.
+
+unsigned int InferenceModel::features(void) const
+{
+    return d_model.features;
+}
+
+
+// unsigned int degree(void) const method
+
+/// Returns the polynomial degree of the feature mapping the model was trained with.
+
+unsigned int InferenceModel::degree(void) const
+{
+    return d_header->degree;
+}
+
+
+// ModelLink link(void) const method
+
+/// Returns the link function of the model.
+
+ModelLink InferenceModel::link(void) const
+{
+    return (ModelLink) d_model.link;
+}
+
+
+// unsigned int labels(void) const method
+
+/// Returns the number of class labels; 0 for a regression model.
+
+unsigned int InferenceModel::labels(void) const
+{
+    return d_header->labels;
+}
+
+
+// double label(const unsigned int) const method
+
+/// Returns the label of a class, as returned by classify().
+/// @param k Class index < labels().
+
+double InferenceModel::label(const unsigned int k) const
+{
+    if(k >= d_header->labels)
+    {
+        cerr << "Regression: InferenceModel class." << endl
+             << "double label(const unsigned int) const method." << endl
+             << "Class index: " << k << " must be < number of labels: " << d_header->labels
+             << endl;
+
+        exit(1);
+    }
+
+    return d_model.label[k];
+}
+
+
+// void predict(const double*, double*) const method
+
+/// Returns h_Ө(x) for a raw instance. Does not allocate.
+/// @param x Raw instance of N() attributes.
+/// @param h Buffer of K() doubles to hold the prediction.
+
+void InferenceModel::predict(const double* x, double* h) const
+{
+    frozenLogits(d_model, x, h);
+    frozenLink(d_model.link, h, d_model.classes);
+}
+
+
+// unsigned int classify(const double*, double*) const method
+
+/// Returns the predicted class index of a raw instance, the arg max of its logits. Does not allocate.
+/// @param x Raw instance of N() attributes.
+/// @param z Buffer of K() doubles, left holding the logits.
+
+unsigned int InferenceModel::classify(const double* x, double* z) const
+{
+    frozenLogits(d_model, x, z);
+    return frozenArgmax(z, d_model.classes);
+}
+
+
+// void features(const double*, double*) const method
+
+/// Maps and normalizes a raw instance, for callers that batch instances into a GEMM with theta().
+/// @param x Raw instance of N() attributes.
+/// @param v Buffer of features() doubles to hold the features.
+
+void InferenceModel::features(const double* x, double* v) const
+{
+    for(uint32_t f=0; f<d_model.features; f++)
+    {
+        v[f] = frozenFeature(d_model, x, f);
+    }
+}
+
+
+// const double* theta(void) const method
+
+/// Returns Ө as a Kx(features()+1) column-major matrix: one column per feature, bias first.
+
+const double* InferenceModel::theta(void) const
+{
+    return d_model.theta;
+}
+
+
+// void applyLink(double*) const method
+
+/// Applies the link of the model in place to the K() logits of a single instance.
+/// @param z Buffer of K() logits.
+
+void InferenceModel::applyLink(double* z) const
+{
+    frozenLink(d_model.link, z, d_model.classes);
+}
@@ -0,0 +1,63 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   I N F E R E N C E   M O D E L   C L A S S   H E A D E R                                */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef INFERENCE_MODEL_H
+#define INFERENCE_MODEL_H
+
+#include<iostream>
+#include<string>
+#include<stdint.h>
+#include<stddef.h>
+
+#include "model_file.h"
+
+using namespace std;
+
+//--A model file mapped read-only into memory and served in place. Part of the inference library, --//
+//--which depends on neither Armadillo nor the training code; loading is open, mmap and a header check.--//
+class InferenceModel
+{
+public:
+    InferenceModel(const string&);
+    ~InferenceModel();
+
+    InferenceModel(const InferenceModel&) = delete;
+    InferenceModel& operator=(const InferenceModel&) = delete;
+
+    unsigned int N(void) const;
+    unsigned int K(void) const;
+    unsigned int features(void) const;
+    unsigned int degree(void) const;
+    ModelLink link(void) const;
+
+    unsigned int labels(void) const;
+    double label(const unsigned int) const;
+
+    void predict(const double*, double*) const;
+    unsigned int classify(const double*, double*) const;
+
+    void features(const double*, double*) const;
+    const double* theta(void) const;
+    void applyLink(double*) const;
+
+private:
+    void* d_image;
+    size_t d_bytes;
+
+    const ModelFileHeader* d_header;
+    FrozenModel d_model;
+};
+
+#endif // INFERENCE_MODEL_H
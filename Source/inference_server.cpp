@@ -0,0 +1,414 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   I N F E R E N C E   S E R V E R   C L A S S                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "inference_server.h"
+
+#include<math.h>
+#include<string.h>
+#include<unistd.h>
+#include<algorithm>
+#include<sys/socket.h>
+#include<sys/un.h>
+
+static unsigned int histogramBucket(const double v)
+{
+    if(v < 1.0)
+    {
+        return 0;
+    }
+
+    unsigned int b = (unsigned int) log2(v) + 1;
+
+    return (b < SERVER_HISTOGRAM_BUCKETS) ? b : SERVER_HISTOGRAM_BUCKETS - 1;
+}
+
+static void printHistogram(const vector<unsigned long>& histogram)
+{
+    for(unsigned int b=0; b<histogram.size(); b++)
+    {
+        if(histogram[b])
+        {
+            cout << ((b == 0) ? 0 : (1ul << (b-1))) << "-" << (1ul << b) << "  " << histogram[b] << endl;
+        }
+    }
+}
+
+
+// CONSTRUCTOR
+
+/// Maps the model file to serve.
+/// @param modelFile Path of a model file written by Predictor::save().
+/// @param window Initial batch window in microseconds.
+
+InferenceServer::InferenceServer(const string& modelFile, const unsigned int window):d_model(modelFile),
+    d_ThetaT(const_cast<double*>(d_model.theta()), d_model.K(), d_model.features() + 1, false, true)
+{
+    d_window = chrono::microseconds(window);
+    d_stop = false;
+    d_listener = -1;
+
+    d_requests = 0;
+    d_batches = 0;
+    d_depth_histogram.assign(SERVER_HISTOGRAM_BUCKETS, 0);
+    d_latency_histogram.assign(SERVER_HISTOGRAM_BUCKETS, 0);
+}
+
+
+// void serve(const string&) method
+
+/// Accepts connections on a UNIX domain socket until a client sends Shutdown, then prints a final report.
+/// An existing socket file at the path is replaced.
+/// @param socketPath Path of the socket.
+
+void InferenceServer::serve(const string& socketPath)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if(socketPath.size() >= sizeof(address.sun_path))
+    {
+        cerr << "Regression: InferenceServer class." << endl
+             << "void serve(const string&) method." << endl
+             << "Socket path: " << socketPath << " must be shorter than " << sizeof(address.sun_path) << " characters."
+             << endl;
+
+        exit(1);
+    }
+
+    strcpy(address.sun_path, socketPath.c_str());
+    unlink(socketPath.c_str());
+
+    d_listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(d_listener < 0 || bind(d_listener, (sockaddr*) &address, sizeof(address)) || listen(d_listener, SOMAXCONN))
+    {
+        cerr << "Regression: InferenceServer class." << endl
+             << "void serve(const string&) method." << endl
+             << "Cannot listen on socket: " << socketPath
+             << endl;
+
+        exit(1);
+    }
+
+    cout << endl << "Serving on " << socketPath << " (attributes: " << d_model.N() << ", features: " << d_model.features()
+         << ", outputs: " << d_model.K() << ", batch window: " << d_window.count() << "us)" << endl;
+
+    thread batching(&InferenceServer::batcher, this);
+
+    while(true)
+    {
+        int client = accept(d_listener, NULL, NULL);
+
+        unique_lock<mutex> lock(d_mutex);
+
+        if(d_stop)
+        {
+            if(client >= 0)
+            {
+                close(client);
+            }
+            break;
+        }
+
+        if(client >= 0)
+        {
+            d_clients.push_back(client);
+            thread(&InferenceServer::connection, this, client).detach();
+        }
+    }
+
+    //--Wakes the connections blocked on a read, then waits for all of them to close--//
+    {
+        unique_lock<mutex> lock(d_mutex);
+
+        for(unsigned int c=0; c<d_clients.size(); c++)
+        {
+            shutdown(d_clients[c], SHUT_RDWR);
+        }
+
+        d_served.wait(lock, [this]{return d_clients.empty();});
+    }
+
+    batching.join();
+
+    close(d_listener);
+    unlink(socketPath.c_str());
+
+    unique_lock<mutex> lock(d_mutex);
+    report();
+}
+
+
+// void connection(const int) method
+
+/// Serves the messages of one client, one at a time, until it disconnects or the server stops.
+/// @param client Socket of the client.
+
+void InferenceServer::connection(const int client)
+{
+    uint32_t dims[2] = {d_model.N(), d_model.K()};
+
+    vector<double> x(d_model.N());
+    vector<double> h(d_model.K());
+
+    Request r;
+    r.x = &x[0];
+    r.h = &h[0];
+
+    uint32_t opcode;
+    bool open = send(client, dims, sizeof(dims));
+
+    while(open && receive(client, &opcode, sizeof(opcode)))
+    {
+        if(opcode == Predict)
+        {
+            if(!receive(client, &x[0], x.size() * sizeof(double)))
+            {
+                break;
+            }
+
+            unique_lock<mutex> lock(d_mutex);
+
+            if(d_stop)
+            {
+                break;
+            }
+
+            r.arrival = chrono::steady_clock::now();
+            r.done = false;
+            d_queue.push_back(&r);
+            d_arrived.notify_one();
+
+            d_served.wait(lock, [&r]{return r.done;});
+            lock.unlock();
+
+            open = send(client, &h[0], h.size() * sizeof(double));
+        }
+        else if(opcode == SetWindow)
+        {
+            uint32_t window;
+
+            if(!receive(client, &window, sizeof(window)))
+            {
+                break;
+            }
+
+            {
+                unique_lock<mutex> lock(d_mutex);
+                d_window = chrono::microseconds(window);
+            }
+
+            open = send(client, &window, sizeof(window));
+        }
+        else if(opcode == Report)
+        {
+            uint64_t counts[2];
+
+            {
+                unique_lock<mutex> lock(d_mutex);
+
+                counts[0] = d_requests;
+                counts[1] = d_batches;
+                report();
+            }
+
+            open = send(client, counts, sizeof(counts));
+        }
+        else if(opcode == Shutdown)
+        {
+            unique_lock<mutex> lock(d_mutex);
+
+            d_stop = true;
+            d_arrived.notify_all();
+
+            //--Wakes the accept loop--//
+            shutdown(d_listener, SHUT_RDWR);
+            break;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    unique_lock<mutex> lock(d_mutex);
+
+    close(client);
+    d_clients.erase(find(d_clients.begin(), d_clients.end(), client));
+    d_served.notify_all();
+}
+
+
+// void batcher(void) method
+
+/// Waits for the oldest pending request to age by the batch window, or for a full batch, and serves all the
+/// pending requests with one GEMM. Exits once the server stops and the queue has drained.
+
+void InferenceServer::batcher(void)
+{
+    vector<Request*> batch;
+    batch.reserve(SERVER_MAX_BATCH);
+
+    unique_lock<mutex> lock(d_mutex);
+
+    while(true)
+    {
+        d_arrived.wait(lock, [this]{return d_stop || !d_queue.empty();});
+
+        if(d_queue.empty())
+        {
+            break;
+        }
+
+        chrono::steady_clock::time_point deadline = d_queue.front()->arrival + d_window;
+        d_arrived.wait_until(lock, deadline, [this]{return d_stop || d_queue.size() >= SERVER_MAX_BATCH;});
+
+        d_depth_histogram[histogramBucket(d_queue.size())]++;
+
+        batch.clear();
+        while(!d_queue.empty() && batch.size() < SERVER_MAX_BATCH)
+        {
+            batch.push_back(d_queue.front());
+            d_queue.pop_front();
+        }
+
+        lock.unlock();
+        predict(batch);
+        chrono::steady_clock::time_point served = chrono::steady_clock::now();
+        lock.lock();
+
+        for(unsigned int b=0; b<batch.size(); b++)
+        {
+            d_latency_histogram[histogramBucket(chrono::duration<double, micro>(served - batch[b]->arrival).count())]++;
+            batch[b]->done = true;
+        }
+
+        d_requests += batch.size();
+        d_batches++;
+
+        d_served.notify_all();
+    }
+}
+
+
+// void predict(vector<Request*>&) method
+
+/// Maps and normalizes the instances of a batch into the columns of [1; X̂'], and computes h = g(Ө'[1; X̂']).
+/// @param batch Pending requests.
+
+void InferenceServer::predict(vector<Request*>& batch)
+{
+    unsigned int F = d_model.features();
+    unsigned int K = d_model.K();
+
+    mat X(F + 1, batch.size());
+
+    for(unsigned int b=0; b<batch.size(); b++)
+    {
+        double* column = X.colptr(b);
+
+        column[0] = 1.0;
+        d_model.features(batch[b]->x, column + 1);
+    }
+
+    mat H = d_ThetaT * X;
+
+    for(unsigned int b=0; b<batch.size(); b++)
+    {
+        d_model.applyLink(H.colptr(b));
+        memcpy(batch[b]->h, H.colptr(b), K * sizeof(double));
+    }
+}
+
+
+// void report(void) method
+
+/// Prints the queue depth seen by each batch and the latency of each request since the last report, from
+/// arrival of the whole request to its answer being ready, then clears them. Called with d_mutex held.
+
+void InferenceServer::report(void)
+{
+    cout << endl << "Inference server report (" << d_requests << " requests, " << d_batches << " batches, mean batch: "
+         << (d_batches ? ((double) d_requests / d_batches) : 0.0) << ", window: " << d_window.count() << "us)"
+         << endl << "#Queue_depth  #Batches" << endl;
+    printHistogram(d_depth_histogram);
+
+    cout << "#Latency(us)  #Requests" << endl;
+    printHistogram(d_latency_histogram);
+
+    d_requests = 0;
+    d_batches = 0;
+    d_depth_histogram.assign(SERVER_HISTOGRAM_BUCKETS, 0);
+    d_latency_histogram.assign(SERVER_HISTOGRAM_BUCKETS, 0);
+}
+
+
+// bool receive(const int, void*, const size_t) method
+
+/// Reads exactly the given number of bytes from a socket. Returns false on error or end of stream.
+/// @param fd Socket.
+/// @param buffer Buffer of at least bytes.
+/// @param bytes Number of bytes to read.
+
+bool InferenceServer::receive(const int fd, void* buffer, const size_t bytes)
+{
+    char* at = (char*) buffer;
+    size_t left = bytes;
+
+    while(left)
+    {
+        ssize_t n = recv(fd, at, left, 0);
+
+        if(n <= 0)
+        {
+            return false;
+        }
+
+        at += n;
+        left -= n;
+    }
+
+    return true;
+}
+
+
+// bool send(const int, const void*, const size_t) method
+
+/// Writes exactly the given number of bytes to a socket. Returns false on error, including a closed peer.
+/// @param fd Socket.
+/// @param buffer Buffer of at least bytes.
+/// @param bytes Number of bytes to write.
+
+bool InferenceServer::send(const int fd, const void* buffer, const size_t bytes)
+{
+    const char* at = (const char*) buffer;
+    size_t left = bytes;
+
+    while(left)
+    {
+        ssize_t n = ::send(fd, at, left, MSG_NOSIGNAL);
+
+        if(n <= 0)
+        {
+            return false;
+        }
+
+        at += n;
+        left -= n;
+    }
+
+    return true;
+}
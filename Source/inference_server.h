@@ -0,0 +1,92 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   I N F E R E N C E   S E R V E R   C L A S S   H E A D E R                              */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef INFERENCE_SERVER_H
+#define INFERENCE_SERVER_H
+
+#include<iostream>
+#include<string>
+#include<vector>
+#include<deque>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<chrono>
+#include<stdint.h>
+
+#include "armadillo"
+#include "inference_model.h"
+
+using namespace std;
+using namespace arma;
+
+#define SERVER_MAX_BATCH 256            //--Instances coalesced into one GEMM at most--//
+#define SERVER_HISTOGRAM_BUCKETS 24     //--Bucket b > 0 of a histogram counts values in [2^(b-1), 2^b), bucket 0 values < 1--//
+
+//--Serves a model file over a UNIX domain socket. On connecting, a client receives N and K as two     --//
+//--uint32; each message then starts with a uint32 opcode:                                           --//
+//--  Predict:   N doubles of a raw instance, answered with K doubles of h_Ө(x)                       --//
+//--  SetWindow: uint32 batch window in us, answered with the same uint32                            --//
+//--  Report:    answered with the uint64 requests and batches since the last report, after printing --//
+//--             the queue depth and latency histograms of that period                               --//
+//--  Shutdown:  stops the server; no answer                                                         --//
+//--Requests that arrive within the window of the oldest pending one are served by a single GEMM.     --//
+class InferenceServer
+{
+public:
+    enum Opcode{Predict, SetWindow, Report, Shutdown};
+
+    InferenceServer(const string&, const unsigned int);
+
+    void serve(const string&);
+
+    static bool receive(const int, void*, const size_t);
+    static bool send(const int, const void*, const size_t);
+
+private:
+    struct Request
+    {
+        const double* x;
+        double* h;
+        chrono::steady_clock::time_point arrival;
+        bool done;
+    };
+
+    void connection(const int);
+    void batcher(void);
+    void predict(vector<Request*>&);
+    void report(void);
+
+    InferenceModel d_model;
+    mat d_ThetaT;                   //--Kx(F+1) view of the mapped Ө--//
+
+    mutex d_mutex;
+    condition_variable d_arrived;
+    condition_variable d_served;
+    deque<Request*> d_queue;
+    chrono::microseconds d_window;
+    bool d_stop;
+
+    int d_listener;
+    vector<int> d_clients;          //--Open connections, each served by a detached thread--//
+
+    //--Statistics since the last report, written by the batcher under d_mutex--//
+    unsigned long d_requests;
+    unsigned long d_batches;
+    vector<unsigned long> d_depth_histogram;
+    vector<unsigned long> d_latency_histogram;
+};
+
+#endif // INFERENCE_SERVER_H
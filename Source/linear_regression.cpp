@@ -18,7 +18,26 @@
 
 LinearRegression::LinearRegression(const DataSet& ds):Regression(ds, "Regression")
 {
+    d_kernels = makeModelKernels<IdentityLink, SquaredLoss, L2Penalty>();
+}
+
+
+LinearRegression::LinearRegression(const DataSet& ds, const unsigned int targets):Regression(ds, "Regression")
+{
+    d_kernels = makeModelKernels<IdentityLink, SquaredLoss, L2Penalty>();
+
+    if(!targets)
+    {
+        cerr << "Regression: LinearRegression class." << endl
+             << "LinearRegression(const DataSet&, const unsigned int) constructor" << endl
+             << "Number of targets: " << targets << " must be > 0." << endl;
+
+        exit(1);
+    }
 
+    //--One column of Ө per target; all targets share X and are fitted together--//
+    d_Theta.set_size(d_Theta.n_rows, targets);
+    init_theta();
 }
 
 
@@ -33,12 +52,9 @@ vec LinearRegression::h_Theta(vec x) const
         exit(1);
     }
 
-    //--Insert 1.0 to the first row of the vector--//
-    x.insert_rows(0,1);
-    x(0) = 1.0;
-
-    //--h_Ө(x) = Ө'x--//
-    vec h = d_Theta.t() * x;
+    //--h_Ө(x) = Ө'x, with the bias folded in by the kernel--//
+    vec h(d_Theta.n_cols);
+    d_kernels.predict(d_Theta, x.memptr(), h.memptr());
 
     return(h);
 }
@@ -55,6 +71,15 @@ double LinearRegression::cost(mat& X, const mat& Y) const
         exit(1);
     }
 
+    if(Y.n_cols != d_Theta.n_cols)
+    {
+        cerr << "Regression: LinearRegression class." << endl
+             << "double cost(mat&, const vec&) const method" << endl
+             << "Colums of matrix Y: "<< Y.n_cols  << " must be equal to the number of targets: " << d_Theta.n_cols << endl;
+
+        exit(1);
+    }
+
     if(X.n_cols != d_Theta.n_rows && X.n_cols != d_Theta.n_rows-1)
     {
         cerr << "Regression: LinearRegression class." << endl
@@ -65,7 +90,7 @@ double LinearRegression::cost(mat& X, const mat& Y) const
     }
 
     double m = X.n_rows;
-    vec cost;
+    double cost;
     bool bias_term_added = false;
 
     if(X.n_cols == d_Theta.n_rows-1)
@@ -76,23 +101,20 @@ double LinearRegression::cost(mat& X, const mat& Y) const
         bias_term_added = true;
     }
 
-    mat theta = d_Theta;
-    theta.row(0).zeros();
-
     //--           _                                   _ --//
     //--        1 |  m                         n        |--//
     //--J(Ө) = ---|  ∑[h_Ө(x⁽i⁾) - y⁽i⁾]^2 +  λ∑(Ө_j)^2]|--//
     //--       2m |_ i                         j       _|--//
 
-    mat residue = ((X * d_Theta) - Y);
-    cost = (1.0/(2.0*m)) * ((residue.t() * residue) + (d_lamda * accu(theta % theta)));
+    //--Summed over all targets; with a single target this is r'r--//
+    cost = d_kernels.cost(X, Y, d_Theta, d_lamda, false);
 
     if(bias_term_added)
     {
         X.shed_col(0);
     }
 
-    return(cost(0));
+    return(cost);
 }
 
 
@@ -100,10 +122,6 @@ mat LinearRegression::derivative(const mat& X, const mat& Y) const
 {
     //vec y = d_dset.yTrain();
 
-    mat DeltaTheta;
-    mat theta = d_Theta;
-    theta.row(0).zeros();
-
     //-- ∂h_Ө(X)                         --//
     //-- -------- = (X'(XΘ - y)), ∀ j = 0--//
     //--   ∂Θ_j                          --//
@@ -112,18 +130,69 @@ mat LinearRegression::derivative(const mat& X, const mat& Y) const
     //-- -------- = (X'(XΘ - y)) + λӨ_j), ∀ j >= 1--//
     //--   ∂Θ_j                                   --//
 
-    DeltaTheta = (X.t() * ((X * d_Theta) - Y)) + (d_lamda * theta);
+    return d_kernels.derivative(X, Y, d_Theta, d_lamda, false);
+}
 
-    return DeltaTheta;
+
+double LinearRegression::normalEquation(mat X, const mat Y)
+{
+    if(X.n_cols != d_Theta.n_rows-1 || X.n_rows != Y.n_rows || Y.n_cols != d_Theta.n_cols)
+    {
+        cerr << "Regression: LinearRegression class." << endl
+             << "double normalEquation(mat, const mat) method" << endl
+             << "Matrix X: " << X.n_rows << "x" << X.n_cols << ", matrix Y: " << Y.n_rows << "x" << Y.n_cols
+             << " and Theta: " << d_Theta.n_rows << "x" << d_Theta.n_cols << " are incompatable." << endl;
+
+        exit(1);
+    }
+
+    //--Adding bias terms to the data--//
+    vec X_0 = ones<vec>(X.n_rows);
+    X.insert_cols(0, X_0);
+
+    //--(X'X + λL)Ө = X'Y, with L = I except L_00 = 0 so the bias is not regularized--//
+    mat A = X.t() * X;
+    mat B = X.t() * Y;
+
+    A.diag() += d_lamda;
+    A(0,0) -= d_lamda;
+
+    //--A single Cholesky factorization A = R'R serves all the target columns of B--//
+    mat R;
+    if(chol(R, A))
+    {
+        d_Theta = solve(trimatu(R), solve(trimatl(R.t()), B));
+    }
+    else
+    {
+        //--A is singular (λ = 0 with collinear features): fall back to a general solver--//
+        d_Theta = solve(A, B);
+    }
+
+    double c = cost(X, Y);
+
+    cout << endl << "Finished direct solve. Training details:"
+         << endl << "Targets: " << d_Theta.n_cols
+         << endl << "J(Theta): " << c << endl;
+
+    recordLamdaCost(c);
+
+    return c;
+}
+
+
+unsigned int LinearRegression::targets(void) const
+{
+    return d_Theta.n_cols;
 }
 
 
-vec LinearRegression::predict(mat X) const
+mat LinearRegression::predict(mat X) const
 {
     if(X.n_cols != d_Theta.n_rows-1)
     {
         cerr << "Regression: LinearRegression class." << endl
-             << "vec predict(mat) const method" << endl
+             << "mat predict(mat) const method" << endl
              << "Colum size of matrix X: "<< X.n_cols  << " and size of vector Theta: " << d_Theta.n_rows << " are incompatable." << endl;
 
         exit(1);
@@ -22,12 +22,17 @@ class LinearRegression: public Regression
 {
 public:
     LinearRegression(const DataSet&);
+    LinearRegression(const DataSet&, const unsigned int);
 
     virtual vec h_Theta(vec) const;
     virtual double cost(mat&, const mat&) const;
     virtual mat derivative(const mat&, const mat&) const;
 
-    vec predict(mat) const;
+    double normalEquation(mat, const mat);
+
+    unsigned int targets(void) const;
+
+    mat predict(mat) const;
     //double test(mat, const vec) const;
     void create_model(const unsigned int) const;
 };
@@ -0,0 +1,254 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   L O A D   G E N E R A T O R   C L A S S                                                */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "load_generator.h"
+#include "inference_server.h"
+
+#include<math.h>
+#include<string.h>
+#include<unistd.h>
+#include<algorithm>
+#include<chrono>
+#include<random>
+#include<thread>
+#include<sys/socket.h>
+#include<sys/un.h>
+
+
+// CONSTRUCTOR
+
+/// @param socketPath Path of the server's socket.
+/// @param modelFile Path of the model file the server serves.
+
+LoadGenerator::LoadGenerator(const string& socketPath, const string& modelFile):d_model(modelFile)
+{
+    d_socket = socketPath;
+}
+
+
+// void run(const vector<unsigned int>&, const unsigned int, const double) const method
+
+/// Sets each batch window on the server in turn and drives it with closed-loop clients, printing the
+/// throughput, client-side p50/p99 latency and the mean batch the server formed, per window.
+/// @param windows Batch windows in microseconds.
+/// @param clients Number of concurrent clients > 0.
+/// @param seconds Duration of the load at each window > 0.
+
+void LoadGenerator::run(const vector<unsigned int>& windows, const unsigned int clients, const double seconds) const
+{
+    if(!clients || seconds <= 0)
+    {
+        cerr << "Regression: LoadGenerator class." << endl
+             << "void run(const vector<unsigned int>&, const unsigned int, const double) const method." << endl
+             << "Clients: " << clients << " and seconds: " << seconds << " must both be > 0."
+             << endl;
+
+        exit(1);
+    }
+
+    int control = connectServer();
+    uint64_t counts[2];
+
+    //--Clears the statistics the server gathered before this run--//
+    uint32_t opcode = InferenceServer::Report;
+    InferenceServer::send(control, &opcode, sizeof(opcode));
+    InferenceServer::receive(control, counts, sizeof(counts));
+
+    cout << endl << "Load generator (" << clients << " clients, " << seconds << "s per window)"
+         << endl << "#Window(us)  #Requests/s  #p50(us)  #p99(us)  #Mean_batch  #Max_error" << endl;
+
+    for(unsigned int w=0; w<windows.size(); w++)
+    {
+        uint32_t message[2] = {InferenceServer::SetWindow, windows[w]};
+        uint32_t ack;
+
+        if(!InferenceServer::send(control, message, sizeof(message)) || !InferenceServer::receive(control, &ack, sizeof(ack)))
+        {
+            cerr << "Regression: LoadGenerator class." << endl
+                 << "void run(const vector<unsigned int>&, const unsigned int, const double) const method." << endl
+                 << "Lost the connection to the server."
+                 << endl;
+
+            exit(1);
+        }
+
+        vector< vector<double> > latency(clients);
+        vector<double> error(clients, 0.0);
+        vector<thread> threads;
+
+        for(unsigned int c=0; c<clients; c++)
+        {
+            threads.push_back(thread(&LoadGenerator::client, this, c, seconds, ref(latency[c]), ref(error[c])));
+        }
+
+        for(unsigned int c=0; c<clients; c++)
+        {
+            threads[c].join();
+        }
+
+        opcode = InferenceServer::Report;
+        InferenceServer::send(control, &opcode, sizeof(opcode));
+        InferenceServer::receive(control, counts, sizeof(counts));
+
+        vector<double> all;
+        double max_error = 0;
+
+        for(unsigned int c=0; c<clients; c++)
+        {
+            all.insert(all.end(), latency[c].begin(), latency[c].end());
+            max_error = (error[c] > max_error) ? error[c] : max_error;
+        }
+
+        sort(all.begin(), all.end());
+
+        double p50 = all.empty() ? 0.0 : all[all.size() / 2];
+        double p99 = all.empty() ? 0.0 : all[(all.size() * 99) / 100];
+
+        cout << windows[w] << "  " << (all.size() / seconds) << "  " << p50 << "  " << p99 << "  "
+             << (counts[1] ? ((double) counts[0] / counts[1]) : 0.0) << "  " << max_error << endl;
+    }
+
+    close(control);
+}
+
+
+// void stop(void) const method
+
+/// Asks the server to shut down.
+
+void LoadGenerator::stop(void) const
+{
+    int server = connectServer();
+
+    uint32_t opcode = InferenceServer::Shutdown;
+    InferenceServer::send(server, &opcode, sizeof(opcode));
+
+    close(server);
+}
+
+
+// int connectServer(void) const method
+
+/// Connects to the server and checks that it serves a model of the same shape as the local one.
+/// Returns the connected socket.
+
+int LoadGenerator::connectServer(void) const
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, d_socket.c_str(), sizeof(address.sun_path) - 1);
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    uint32_t dims[2];
+
+    if(server < 0 || connect(server, (sockaddr*) &address, sizeof(address)) || !InferenceServer::receive(server, dims, sizeof(dims)))
+    {
+        cerr << "Regression: LoadGenerator class." << endl
+             << "int connectServer(void) const method." << endl
+             << "Cannot connect to the server on socket: " << d_socket
+             << endl;
+
+        exit(1);
+    }
+
+    if(dims[0] != d_model.N() || dims[1] != d_model.K())
+    {
+        cerr << "Regression: LoadGenerator class." << endl
+             << "int connectServer(void) const method." << endl
+             << "Server model: " << dims[0] << " attributes and " << dims[1] << " outputs does not match the local model: "
+             << d_model.N() << " attributes and " << d_model.K() << " outputs."
+             << endl;
+
+        exit(1);
+    }
+
+    return server;
+}
+
+
+// void client(const unsigned int, const double, vector<double>&, double&) const method
+
+/// Sends requests one after another for the given duration, recording the round trip of each.
+/// @param seed Seed of the random instances.
+/// @param seconds Duration of the load.
+/// @param latency Round trip of each request in microseconds.
+/// @param max_error Max |h_server - h_local| over the checked answers.
+
+void LoadGenerator::client(const unsigned int seed, const double seconds, vector<double>& latency, double& max_error) const
+{
+    unsigned int n = d_model.N();
+    unsigned int K = d_model.K();
+
+    //--Each message is the opcode followed by the raw instance, sent with a single write--//
+    size_t message_bytes = sizeof(uint32_t) + (n * sizeof(double));
+    vector<char> messages(LOADGEN_INSTANCES * message_bytes);
+
+    mt19937 rng(seed);
+    uniform_real_distribution<double> attribute(-1.0, 1.0);
+
+    for(unsigned int i=0; i<LOADGEN_INSTANCES; i++)
+    {
+        char* message = &messages[i * message_bytes];
+        uint32_t opcode = InferenceServer::Predict;
+
+        memcpy(message, &opcode, sizeof(opcode));
+
+        for(unsigned int j=0; j<n; j++)
+        {
+            double x = attribute(rng);
+            memcpy(message + sizeof(uint32_t) + (j * sizeof(double)), &x, sizeof(double));
+        }
+    }
+
+    vector<double> x(n);
+    vector<double> h(K);
+    vector<double> h_local(K);
+
+    int server = connectServer();
+
+    chrono::steady_clock::time_point end = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(seconds));
+
+    for(unsigned long r=0; ; r++)
+    {
+        const char* message = &messages[(r % LOADGEN_INSTANCES) * message_bytes];
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        if(start >= end)
+        {
+            break;
+        }
+
+        if(!InferenceServer::send(server, message, message_bytes) || !InferenceServer::receive(server, &h[0], K * sizeof(double)))
+        {
+            break;
+        }
+
+        latency.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+
+        if(r < LOADGEN_CHECKS)
+        {
+            memcpy(&x[0], message + sizeof(uint32_t), n * sizeof(double));
+            d_model.predict(&x[0], &h_local[0]);
+
+            for(unsigned int k=0; k<K; k++)
+            {
+                max_error = (fabs(h[k] - h_local[k]) > max_error) ? fabs(h[k] - h_local[k]) : max_error;
+            }
+        }
+    }
+
+    close(server);
+}
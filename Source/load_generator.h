@@ -0,0 +1,50 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   L O A D   G E N E R A T O R   C L A S S   H E A D E R                                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+#include<iostream>
+#include<string>
+#include<vector>
+#include<stdint.h>
+
+#include "inference_model.h"
+
+using namespace std;
+
+#define LOADGEN_INSTANCES 64        //--Random raw instances each client cycles through--//
+#define LOADGEN_CHECKS 16           //--Answers per client checked against the local model--//
+
+//--Closed-loop clients of an InferenceServer: each sends a request, waits for its answer and sends the--//
+//--next, so the offered load grows with the number of clients and the server's batching decides the  --//
+//--rest. The model file the server serves is mapped locally to check its answers.                   --//
+class LoadGenerator
+{
+public:
+    LoadGenerator(const string&, const string&);
+
+    void run(const vector<unsigned int>&, const unsigned int, const double) const;
+    void stop(void) const;
+
+private:
+    int connectServer(void) const;
+    void client(const unsigned int, const double, vector<double>&, double&) const;
+
+    string d_socket;
+    InferenceModel d_model;
+};
+
+#endif // LOAD_GENERATOR_H
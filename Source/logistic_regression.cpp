@@ -14,11 +14,13 @@
 /********************************************************************************************/
 
 #include "logistic_regression.h"
+#include "simd_math.h"
 
 
 LogisticRegression::LogisticRegression(const DataSet& ds):Regression(ds, "Classification")
 {
     d_class_func = Softmax;
+    d_kernels = makeModelKernels<SoftmaxLink, CrossEntropyLoss, L2Penalty>();
     d_classification_threshold = 0.5;
 }
 
@@ -34,38 +36,21 @@ vec LogisticRegression::h_Theta(vec x) const
         exit(1);
     }
 
-    //--Insert 1.0 to the first row of the data vector--//
-    x.insert_rows(0,1);
-    x(0) = 1.0;
+    //--h_Ө(x) = sigmoid(Ө'x) or softmax(Ө'x), with the bias folded in by the kernel--//
+    vec h(d_Theta.n_cols);
+    d_kernels.predict(d_Theta, x.memptr(), h.memptr());
 
-    if(d_class_func == Sigmoid)
-    {
-        //--h_Ө(x) = sigmoid(Ө'x)--//
-        return sigmoid(d_Theta.t() * x);
-    }
-    else if(d_class_func == Softmax)
-    {
-        //--h_Ө(x) = softmax(Ө'x)--//
-        return softmax(d_Theta.t() * x);
-    }
-    else
-    {
-        cerr << "Regression: LogisticRegression class." << endl
-             << "vec h_Theta(vec) const method" << endl
-             << "Invalid classification function type: "<< d_class_func  << endl;
-
-        exit(1);
-    }
+    return h;
 }
 
 
 double LogisticRegression::cost(mat& X, const mat& Y) const
 {
-    if(X.n_rows != Y.n_cols)
+    if(X.n_rows != Y.n_rows || Y.n_cols != 1)
     {
         cerr << "Regression: LogisticRegression class." << endl
              << "double cost(mat&, const vec&) const method" << endl
-             << "Rows of matrix X: "<< X.n_rows  << " must be equal to cols of KxM matrix Y: " << Y.n_cols << endl;
+             << "Rows of matrix X: "<< X.n_rows  << " must be equal to rows of Mx1 class indices Y: " << Y.n_rows << "x" << Y.n_cols << endl;
 
         exit(1);
     }
@@ -81,7 +66,7 @@ double LogisticRegression::cost(mat& X, const mat& Y) const
     }
 
     double m = X.n_rows;
-    mat cost;
+    double cost;
     bool bias_term_added = false;
 
     if(X.n_cols == d_Theta.n_rows-1)
@@ -92,27 +77,6 @@ double LogisticRegression::cost(mat& X, const mat& Y) const
         bias_term_added = true;
     }
 
-    mat h_theta;
-    if(d_class_func == Sigmoid)
-    {
-        h_theta = sigmoid(X * d_Theta);
-    }
-    else if(d_class_func == Softmax)
-    {
-        h_theta = softmax(X * d_Theta);
-    }
-    else
-    {
-        cerr << "Regression: LogisticRegression class." << endl
-             << "double cost(mat, const mat) const method" << endl
-             << "Invalid classification function type: "<< d_class_func  << endl;
-
-        exit(1);
-    }
-
-    mat theta = d_Theta;
-    theta.row(0).zeros();
-
     //--        1  m                                 --//
     //--J(Ө) = --- ∑ [-y'⁽i⁾ log(h_Ө(x⁽i⁾))], ∀ j = 0--//
     //--        m  i                                 --//
@@ -121,55 +85,142 @@ double LogisticRegression::cost(mat& X, const mat& Y) const
     //--J(Ө) = --- ∑ [-y'⁽i⁾ log(h_Ө(x⁽i⁾))] + ---- ∑(Ө_j)^2, ∀ j >= 1--//
     //--        m  i                            2m  j                 --//
 
-    cost = ((-1.0/m) * accu(Y.t() % log(h_theta))) + ((d_lamda / (2.0*m)) * (accu(theta % theta)));
+    cost = d_kernels.cost(X, Y, d_Theta, d_lamda, true);
 
     if(bias_term_added)
     {
         X.shed_col(0);
     }
 
-    return(cost(0,0));
+    return(cost);
 }
 
 
 mat LogisticRegression::derivative(const mat& X, const mat& Y) const
 {
-    mat DeltaTheta;
-    mat theta = d_Theta;
-    theta.row(0).zeros();
+    //--            _                              _          --//
+    //--  ∂J(Ө)    |  m                             |         --//
+    //-- ------- = |  ∑ [h_Ө(x⁽i⁾) - y⁽i⁾] (x_j)⁽i⁾ |, ∀ j = 0--//
+    //--   ∂Θ_j    |_ i                            _|         --//
 
-    mat h_theta;
+    //--            _                                     _           --//
+    //--  ∂J(Ө)    |  m                                    |          --//
+    //-- ------- = |  ∑ [h_Ө(x⁽i⁾) - y⁽i⁾] (x_j)⁽i⁾ + λӨ_j |, ∀ j >= 1--//
+    //--   ∂Θ_j    |_ i                                   _|          --//
 
-    if(d_class_func == Sigmoid)
-    {
-        h_theta = sigmoid(X * d_Theta);
-    }
-    else if(d_class_func == Softmax)
+    return d_kernels.derivative(X, Y, d_Theta, d_lamda, true);
+}
+
+
+double LogisticRegression::oneVsRest(const mat& X, const mat& Y, const double delta, const unsigned int max_iter, const unsigned int threads)
+{
+    DataView train_view(X, Y, trainingLabels());
+
+    return oneVsRest(train_view, delta, max_iter, threads);
+}
+
+
+double LogisticRegression::oneVsRest(const mat& X, const mat& Y, const uvec& rows, const double delta, const unsigned int max_iter, const unsigned int threads)
+{
+    //--Every class is trained on the rows of X listed in rows, gathered one tile at a time; X is never copied--//
+    DataView train_view(X, Y, trainingLabels(), rows);
+
+    return oneVsRest(train_view, delta, max_iter, threads);
+}
+
+
+double LogisticRegression::oneVsRest(const QuantizedMatrix& X, const mat& Y, const double delta, const unsigned int max_iter, const unsigned int threads)
+{
+    DataView train_view(X, Y, trainingLabels());
+
+    return oneVsRest(train_view, delta, max_iter, threads);
+}
+
+
+double LogisticRegression::oneVsRest(const DataView& train_view, const double delta, const unsigned int max_iter, const unsigned int threads)
+{
+    if(d_class_func != Sigmoid)
     {
-        h_theta = softmax(X * d_Theta);
+        cerr << "Regression: LogisticRegression class." << endl
+             << "double oneVsRest(const DataView&, const double, const unsigned int, const unsigned int) method" << endl
+             << "One-vs-rest training requires the Sigmoid classification function." << endl;
+
+        exit(1);
     }
-    else
+
+    const mat& Y = train_view.Y();
+    bool indexed = train_view.classIndexed();
+    unsigned int rows = train_view.quantized() ? train_view.Xq().M() : train_view.X().n_rows;
+
+    if(train_view.N() != d_Theta.n_rows-1 || rows != (indexed ? Y.n_rows : Y.n_cols) || (!indexed && Y.n_rows != d_Theta.n_cols))
     {
         cerr << "Regression: LogisticRegression class." << endl
-             << "mat derivative(const mat&, const mat&) const method" << endl
-             << "Invalid classification function type: "<< d_class_func  << endl;
+             << "double oneVsRest(const DataView&, const double, const unsigned int, const unsigned int) method" << endl
+             << "Matrix X: " << rows << "x" << train_view.N() << ", labels Y: " << Y.n_rows << "x" << Y.n_cols
+             << " and Theta: " << d_Theta.n_rows << "x" << d_Theta.n_cols << " are incompatable." << endl;
 
         exit(1);
     }
 
-    //--            _                              _          --//
-    //--  ∂J(Ө)    |  m                             |         --//
-    //-- ------- = |  ∑ [h_Ө(x⁽i⁾) - y⁽i⁾] (x_j)⁽i⁾ |, ∀ j = 0--//
-    //--   ∂Θ_j    |_ i                            _|         --//
+    unsigned int classes = d_Theta.n_cols;
 
-    //--            _                                     _           --//
-    //--  ∂J(Ө)    |  m                                    |          --//
-    //-- ------- = |  ∑ [h_Ө(x⁽i⁾) - y⁽i⁾] (x_j)⁽i⁾ + λӨ_j |, ∀ j >= 1--//
-    //--   ∂Θ_j    |_ i                                   _|          --//
+    uvec iterations(classes);
+    vec costs(classes);
+
+    cout << endl << "Training " << classes << " one-vs-rest classifiers..." << endl;
+
+    //--Each column of Ө is an independent binary problem, trained on its own thread until it converges--//
+    ThreadPool pool(threads);
+
+    for(unsigned int k=0; k<classes; k++)
+    {
+        pool.enqueue([this, &train_view, &iterations, &costs, k, delta, max_iter]()
+        {
+            iterations(k) = trainBinary(train_view, k, delta, max_iter, costs(k));
+        });
+    }
+
+    pool.wait();
+
+    cout << endl << "Finished training. Training details:"
+         << endl << "#Class  #Iterations  #J_k(Theta)" << endl;
+
+    for(unsigned int k=0; k<classes; k++)
+    {
+        cout << k << "  " << iterations(k) << "  " << costs(k) << endl;
+    }
+
+    //--J(Ө) is the sum of the per-class costs--//
+    double c = accu(costs);
+    cout << "J(Theta): " << c << endl;
+
+    recordLamdaCost(c);
+
+    return c;
+}
+
+
+unsigned int LogisticRegression::trainBinary(const DataView& train_view, const unsigned int k, const double delta, const unsigned int max_iter, double& c)
+{
+    const mat& Y = train_view.Y();
+
+    //--Targets of class k vs the rest as a 1xM one-hot row, over the same instances as the view--//
+    mat y_k = train_view.classIndexed() ? mat(conv_to<mat>::from(Y.col(0) == k).t()) : mat(Y.row(k));
+    DataView binary(train_view, y_k, DataView::Targets);
+
+    //--        1  m                            λ   n                 --//
+    //--J_k = --- ∑ [-y_k⁽i⁾ log(h_Ө(x⁽i⁾))] + ---- ∑(Ө_jk)^2, ∀ j >= 1--//
+    //--        m  i                            2m  j                 --//
 
-    DeltaTheta = (X.t() * (h_theta - Y.t())) + (d_lamda * theta);
+    //--Ө_k is fitted on its own, one tiled sweep per iteration through fit()'s workspace--//
+    mat theta = d_Theta.col(k);
+    unsigned int it = 0;
 
-    return DeltaTheta;
+    c = fit(binary, theta, delta, max_iter, it);
+
+    d_Theta.col(k) = theta;
+
+    return it;
 }
 
 
@@ -202,10 +253,12 @@ void LogisticRegression::set_classificationFunction(const string& class_func)
     if(class_func == "Sigmoid")
     {
         d_class_func = Sigmoid;
+        d_kernels = makeModelKernels<SigmoidLink, CrossEntropyLoss, L2Penalty>();
     }
     else if(class_func == "Softmax")
     {
         d_class_func = Softmax;
+        d_kernels = makeModelKernels<SoftmaxLink, CrossEntropyLoss, L2Penalty>();
     }
     else
     {
@@ -247,41 +300,41 @@ mat LogisticRegression::sigmoid(const mat z) const
     //-- ---------- --//
     //-- 1 + e^(-z) --//
 
-    return (1.0 / (1.0 + exp((-1.0) * z)));
+    mat h = z;
+    SimdMath::sigmoid(h.memptr(), h.n_elem);
+
+    return h;
 }
 
 
 mat LogisticRegression::softmax(const mat z) const
 {
-    //--   e^(z_i)   --//
-    //-- ----------- --//
-    //-- ∑_j e^(z_j) --//
+    //--   e^(z_i - max(z))   --//
+    //-- -------------------- --//
+    //-- ∑_j e^(z_j - max(z)) --//
 
-    mat e_z = exp(z);
-    vec sum_scores;
-    mat denom;
+    mat p = z;
 
-    if(e_z.n_cols > 1)
+    if(p.n_cols > 1)
     {
-        sum_scores = sum(e_z,1);
-        denom = repmat(sum_scores, 1, e_z.n_cols);
+        SoftmaxLink::tile(p);
     }
     else
     {
-        sum_scores = sum(e_z,0);
-        denom = repmat(sum_scores, e_z.n_rows, 1);
+        p = exp(p - p.max());
+        p /= accu(p);
     }
 
-    return(e_z / denom);
+    return p;
 }
 
 
-mat LogisticRegression::predict(mat X, const mat target) const
+mat LogisticRegression::predict(const mat& X, const mat& target) const
 {
     if(X.n_cols != d_Theta.n_rows-1)
     {
         cerr << "Regression: LogisticRegression class." << endl
-             << "mat predict(const mat, const mat) const method" << endl
+             << "mat predict(const mat&, const mat&) const method" << endl
              << "Colum size of matrix X: "<< X.n_cols  << " and size of vector Theta: " << d_Theta.n_rows << " are incompatable." << endl;
 
         exit(1);
@@ -289,16 +342,11 @@ mat LogisticRegression::predict(mat X, const mat target) const
 
     unsigned int instSize = X.n_rows;
 
-    vec X_0 = ones<vec>(instSize);
-    X.insert_cols(0, X_0);
-
-    mat H;
-    H = sigmoid(X * d_Theta);
+    uvec max_indx;
+    classify(X, max_indx, NULL);
 
     mat Y = zeros<mat>(instSize, target.n_rows);
 
-    ucolvec max_indx = index_max(H,1);
-
     for(unsigned int i=0; i<instSize; i++)
     {
         Y(i, max_indx[i]) = 1.0;
@@ -308,48 +356,110 @@ mat LogisticRegression::predict(mat X, const mat target) const
 }
 
 
-umat LogisticRegression::confusionMatrix(const mat X, const mat labels) const
+void LogisticRegression::classify(const mat& X, uvec& classes, mat* probabilities = NULL) const
 {
-    umat confMat(d_dset.K(), d_dset.K());
-    confMat.zeros();
+    if(X.n_cols != d_Theta.n_rows-1)
+    {
+        cerr << "Regression: LogisticRegression class." << endl
+             << "void classify(const mat&, uvec&, mat*) const method" << endl
+             << "Colum size of matrix X: "<< X.n_cols  << " and row size of Theta: " << d_Theta.n_rows << " are incompatable." << endl;
+
+        exit(1);
+    }
 
-    mat predicted_y = predict(X, labels);
+    unsigned int m = X.n_rows;
+    unsigned int n = d_Theta.n_rows - 1;
+    unsigned int classes_size = d_Theta.n_cols;
 
-    unsigned int instSize = X.n_rows;
-    uvec row_indx;
-    uvec col_indx;
+    //--Z = Ө_0 + XӨ_1..n, straight from X with no bias column, into the caller's buffer when given--//
+    mat logits;
+    mat& Z = probabilities ? *probabilities : logits;
 
-    for(unsigned int i=0; i<instSize; i++)
+    Z = X * d_Theta.rows(1, n);
+    Z.each_row() += d_Theta.row(0);
+
+    //--Sigmoid and softmax are monotone, so the arg max of the logits is the predicted class--//
+    classes.zeros(m);
+
+    for(unsigned int k=1; k<classes_size; k++)
+    {
+        const double* z = Z.colptr(k);
+
+        for(unsigned int i=0; i<m; i++)
+        {
+            if(z[i] > Z(i, classes(i)))
+            {
+                classes(i) = k;
+            }
+        }
+    }
+
+    if(probabilities)
+    {
+        d_kernels.link(*probabilities);
+    }
+}
+
+
+ClassificationMetrics LogisticRegression::metrics(const mat& X, const mat& labels) const
+{
+    if(X.n_rows != labels.n_cols)
+    {
+        cerr << "Regression: LogisticRegression class." << endl
+             << "ClassificationMetrics metrics(const mat&, const mat&) const method" << endl
+             << "Rows of matrix X: " << X.n_rows << " must be equal to cols of KxM one-hot matrix labels: " << labels.n_rows << "x" << labels.n_cols
+             << endl;
+
+        exit(1);
+    }
+
+    uvec actual(X.n_rows);
+    for(unsigned int i=0; i<X.n_rows; i++)
+    {
+        actual(i) = trueClass(labels, DataView::Targets, i);
+    }
+
+    return metrics(X, actual);
+}
+
+
+ClassificationMetrics LogisticRegression::metrics(const mat& X, const uvec& actual) const
+{
+    if(X.n_rows != actual.n_rows)
     {
-        row_indx = find(labels.col(i) == 1, 1);
-        col_indx = find(predicted_y.row(i) == 1, 1);
+        cerr << "Regression: LogisticRegression class." << endl
+             << "ClassificationMetrics metrics(const mat&, const uvec&) const method" << endl
+             << "Rows of matrix X: " << X.n_rows << " must be equal to the number of class indices: " << actual.n_rows
+             << endl;
 
-        confMat(row_indx, col_indx) += 1;
+        exit(1);
     }
 
-    urowvec col_sum = sum(confMat, 0);
-    ucolvec row_sum = sum(confMat, 1);
+    uvec predicted;
+    classify(X, predicted, NULL);
 
-    uvec TP = confMat.diag();
-    uvec TN = accu(confMat) - (col_sum.t() + row_sum) + TP ;
-    uvec FP = sum(confMat, 0).t() - TP;
-    uvec FN = sum(confMat, 1) - TP;
+    unsigned int threads = thread::hardware_concurrency();
 
-    /*mat binartConfMat = zeros<mat>(2, 2);
-    binartConfMat(0,0) = TP(1);
-    binartConfMat(0,1) = confMat(0,1);
-    binartConfMat(1,0) = confMat(1,0);
-    binartConfMat(1,1) = TP(0);*/
+    ClassificationMetrics metrics(d_dset.K(), threads ? threads : 1);
+    metrics.accumulate(actual, predicted);
 
-    return confMat;
+    return metrics;
 }
 
 
-void LogisticRegression::print_confusionMatrix(umat confMat) const
+umat LogisticRegression::confusionMatrix(const mat& X, const mat& labels) const
 {
-    unsigned int total_samples = accu(confMat);
-    unsigned int total_TP = trace(confMat);
+    return metrics(X, labels).confusionMatrix();
+}
 
+
+void LogisticRegression::print_confusionMatrix(const umat& confusion) const
+{
+    unsigned int total_samples = accu(confusion);
+    unsigned int total_TP = trace(confusion);
+
+    //--Printed with the actual labels as a leading column--//
+    umat confMat = confusion;
     uvec actuals = conv_to< uvec >::from(d_dset.labels());
     confMat.insert_cols(0, actuals);
 
@@ -382,42 +492,16 @@ void LogisticRegression::print_confusionMatrix(umat confMat) const
 }
 
 
-double LogisticRegression::f1Score(const mat X, const mat labels, const bool show_stats=false) const
+double LogisticRegression::f1Score(const mat& X, const mat& labels, const bool show_stats=false) const
 {
-    umat confMat = confusionMatrix(X, labels);
-
-    if(show_stats)
-    {
-        print_confusionMatrix(confMat);
-    }
-
-    double TP = confMat(0,0);
-    double TN = confMat(1,1);
-    double FP = confMat(0,1);
-    double FN = confMat(1,0);
-
-    double precision;
-    double recall;
-    double specificity; //--True negative rate--//
-    double accuracy;
-
-    double f1_score;
-
-    precision = TP / (TP + FP);
-    recall = TP / (TP + FN);
-
-    specificity = TN / (TN + FP);
-    accuracy = (TP + TN) / (TP + TN + FP + FN);
+    ClassificationMetrics m = metrics(X, labels);
 
     if(show_stats)
     {
-        cout << endl << "Precision:   " << precision
-             << endl << "Recall:      " << recall
-             << endl << "Specificity: " << specificity
-             << endl << "Accuracy:    " << accuracy << endl;
+        print_confusionMatrix(m.confusionMatrix());
+        m.print(d_dset.labels());
     }
 
-    f1_score = 2.0 * ((precision * recall) / (precision + recall));
-
-    return f1_score;
+    //--Macro F1 over all K classes, each class weighing the same--//
+    return m.macroF1();
 }
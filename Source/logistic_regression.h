@@ -31,6 +31,11 @@ public:
     virtual double cost(mat&, const mat&) const;
     virtual mat derivative(const mat&, const mat&) const;
 
+    double oneVsRest(const mat&, const mat&, const double, const unsigned int, const unsigned int);
+    double oneVsRest(const mat&, const mat&, const uvec&, const double, const unsigned int, const unsigned int);
+    double oneVsRest(const QuantizedMatrix&, const mat&, const double, const unsigned int, const unsigned int);
+    double oneVsRest(const DataView&, const double, const unsigned int, const unsigned int);
+
     string classificationFunction(void) const;
     void set_classificationFunction(const string&);
 
@@ -39,13 +44,18 @@ public:
 
     mat sigmoid(const mat) const;
     mat softmax(const mat) const;
-    mat predict(mat, const mat) const;
+    mat predict(const mat&, const mat&) const;
+    void classify(const mat&, uvec&, mat*) const;
 
-    umat confusionMatrix(const mat, const mat) const;
-    void print_confusionMatrix(const umat) const;
-    double f1Score(const mat, const mat, const bool) const;
+    ClassificationMetrics metrics(const mat&, const mat&) const;
+    ClassificationMetrics metrics(const mat&, const uvec&) const;
+    umat confusionMatrix(const mat&, const mat&) const;
+    void print_confusionMatrix(const umat&) const;
+    double f1Score(const mat&, const mat&, const bool) const;
 
 private:
+    unsigned int trainBinary(const DataView&, const unsigned int, const double, const unsigned int, double&);
+
     ClassificationFunction d_class_func;
     double d_classification_threshold;
 };
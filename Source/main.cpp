@@ -2,6 +2,14 @@
 //#include "regression.h"
 #include "linear_regression.h"
 #include "logistic_regression.h"
+#include "hyperparameter_search.h"
+#include "simd_math.h"
+#include "predictor.h"
+#include "inference_model.h"
+#include "inference_server.h"
+#include "load_generator.h"
+#include "streaming_scorer.h"
+#include "quantized_predictor.h"
 
 #define ALPHA 0.01
 #define LAMDA 1.0
@@ -10,10 +18,40 @@
 
 #define TRAIN_PERCENT 70
 #define TEST_PERCENT 30
+#define STRATIFY true
 
 #define DELTA 0.0000001
 #define MAX_ITERATIONS 1000
 
+#define METRICS_FILE "../Output/regression.prom"
+#define METRICS_FORMAT "Prometheus"
+
+#define CHECKPOINT_FILE "../Output/checkpoint.dat"
+#define CHECKPOINT_INTERVAL 100
+
+#define CV_FOLDS 10
+
+#define HOGWILD_MAX_EPOCHS 20
+#define HOGWILD_TARGET_ACCURACY 0.9
+
+#define SEARCH_MIN_ITERATIONS 50
+#define SEARCH_ETA 3
+
+#define SIMD_BENCHMARK_ELEMENTS 1048576
+#define SIMD_BENCHMARK_REPEATS 20
+
+#define LATENCY_REPEATS 100
+#define MODEL_FILE "../Output/model.bin"
+
+#define SERVER_SOCKET "/tmp/regression.sock"
+#define SERVER_WINDOW 100
+#define LOADGEN_CLIENTS 16
+#define LOADGEN_SECONDS 2.0
+
+#define SCORES_FILE "../Output/scores.dat"
+
+#define INT8_REPEATS 20
+
 void linear_regression(char* fileName=NULL)
 {
     char* dataFileName;
@@ -27,7 +65,7 @@ void linear_regression(char* fileName=NULL)
         dataFileName = "../Data/servo.dat";
     }
 
-    DataSet d(dataFileName, DEGREE, TRAIN_PERCENT, TEST_PERCENT, false);
+    DataSet d(dataFileName, DEGREE, TRAIN_PERCENT, TEST_PERCENT, false, false);
 
     LinearRegression linR(d);
 
@@ -42,7 +80,7 @@ void linear_regression(char* fileName=NULL)
 }
 
 
-void logistic_regression(char* fileName=NULL, const bool MNIST=false)
+void logistic_regression(char* fileName=NULL, const bool MNIST=false, const bool METRICS=false, const bool RESUME=false)
 {
     char* dataFileName;
 
@@ -55,7 +93,7 @@ void logistic_regression(char* fileName=NULL, const bool MNIST=false)
         dataFileName = "../Data/chip.dat";
     }
 
-    DataSet d(dataFileName, DEGREE, TRAIN_PERCENT, TEST_PERCENT, MNIST);
+    DataSet d(dataFileName, DEGREE, TRAIN_PERCENT, TEST_PERCENT, MNIST, STRATIFY);
 
     cout << endl << "Data set size: " << d.X().n_rows << "x" << d.X().n_cols << endl;
 
@@ -64,11 +102,379 @@ void logistic_regression(char* fileName=NULL, const bool MNIST=false)
     logR.set_lamda(LAMDA);
     logR.set_alpha(ALPHA);
 
-    logR.gradientdescent(d.XTrain(), d.Train_oneHotMatrix(), DELTA, MAX_ITERATIONS);
+    MetricsExporter exporter(METRICS_FILE, METRICS_FORMAT);
+    if(METRICS)
+    {
+        logR.add_observer(&exporter);
+    }
+
+    logR.set_checkpoint(CHECKPOINT_FILE, CHECKPOINT_INTERVAL);
+
+    //--MNIST trains from its 8-bit pixels, dequantized one tile at a time; file data sets through the rows of their split--//
+    if(RESUME)
+    {
+        if(MNIST)
+        {
+            logR.resume(d.XTrainQuantized(), d.Train_classIndices(), CHECKPOINT_FILE, DELTA, MAX_ITERATIONS);
+        }
+        else
+        {
+            logR.resume(d.X(), d.classIndices(), d.trainRows(), CHECKPOINT_FILE, DELTA, MAX_ITERATIONS);
+        }
+    }
+    else
+    {
+        if(MNIST)
+        {
+            logR.gradientdescent(d.XTrainQuantized(), d.Train_classIndices(), DELTA, MAX_ITERATIONS);
+        }
+        else
+        {
+            logR.gradientdescent(d.X(), d.classIndices(), d.trainRows(), DELTA, MAX_ITERATIONS);
+        }
+    }
+
+    cout << endl << "F1_Score: " << logR.f1Score(d.XTest(), d.Test_oneHotMatrix(), true) << endl;
+}
+
+void one_vs_rest(char* fileName=NULL, const bool MNIST=false)
+{
+    char* dataFileName;
+
+    if(fileName != NULL)
+    {
+        dataFileName = fileName;
+    }
+    else
+    {
+        dataFileName = "../Data/chip.dat";
+    }
+
+    DataSet d(dataFileName, DEGREE, TRAIN_PERCENT, TEST_PERCENT, MNIST, STRATIFY);
+
+    LogisticRegression logR(d);
+
+    logR.set_lamda(LAMDA);
+    logR.set_alpha(ALPHA);
+    logR.set_classificationFunction("Sigmoid");
+
+    unsigned int threads = thread::hardware_concurrency();
+    if(!threads)
+    {
+        threads = 1;
+    }
+
+    if(MNIST)
+    {
+        logR.oneVsRest(d.XTrainQuantized(), d.Train_classIndices(), DELTA, MAX_ITERATIONS, threads);
+    }
+    else
+    {
+        logR.oneVsRest(d.X(), d.classIndices(), d.trainRows(), DELTA, MAX_ITERATIONS, threads);
+    }
 
     cout << endl << "F1_Score: " << logR.f1Score(d.XTest(), d.Test_oneHotMatrix(), true) << endl;
 }
 
+
+void cross_validation(char* fileName=NULL, const bool MNIST=false)
+{
+    char* dataFileName;
+
+    if(fileName != NULL)
+    {
+        dataFileName = fileName;
+    }
+    else
+    {
+        dataFileName = "../Data/chip.dat";
+    }
+
+    DataSet d(dataFileName, DEGREE, TRAIN_PERCENT, TEST_PERCENT, MNIST, STRATIFY);
+
+    LogisticRegression logR(d);
+
+    logR.set_lamda(LAMDA);
+    logR.set_alpha(ALPHA);
+
+    unsigned int threads = thread::hardware_concurrency();
+    if(!threads)
+    {
+        threads = 1;
+    }
+
+    //--Folds are drawn from the training rows only, so the test split is never seen--//
+    if(MNIST)
+    {
+        logR.crossValidate(d.XTrainQuantized(), d.Train_classIndices(), CV_FOLDS, true, DELTA, MAX_ITERATIONS, threads);
+    }
+    else
+    {
+        logR.crossValidate(d.X(), d.classIndices(), d.trainRows(), CV_FOLDS, true, DELTA, MAX_ITERATIONS, threads);
+    }
+}
+
+
+void hogwild_benchmark(char* fileName=NULL, const bool MNIST=false)
+{
+    char* dataFileName;
+
+    if(fileName != NULL)
+    {
+        dataFileName = fileName;
+    }
+    else
+    {
+        dataFileName = "../Data/chip.dat";
+    }
+
+    DataSet d(dataFileName, DEGREE, TRAIN_PERCENT, TEST_PERCENT, MNIST, STRATIFY);
+
+    LogisticRegression logR(d);
+
+    logR.set_lamda(LAMDA);
+    logR.set_alpha(ALPHA);
+
+    unsigned int max_threads = thread::hardware_concurrency();
+    if(!max_threads)
+    {
+        max_threads = 1;
+    }
+
+    //--The row-compressed X' is built once from the training rows, so the timed epochs run the SGD workers only.--//
+    //--Its columns follow the order of the training rows, as do the class indices of Train_classIndices().      --//
+    sp_mat Xt = MNIST ? DataView(d.XTrainQuantized(), d.Train_classIndices(), DataView::ClassIndices).sparseTranspose()
+                      : DataView(d.X(), d.classIndices(), DataView::ClassIndices, d.trainRows()).sparseTranspose();
+
+    cout << endl << "Hogwild benchmark (target accuracy: " << HOGWILD_TARGET_ACCURACY << ")"
+         << endl << "#Threads  #Updates/s  #Epochs  #Time-to-accuracy(s)  #Accuracy" << endl;
+
+    for(unsigned int threads=1; threads<=max_threads; threads*=2)
+    {
+        logR.init_theta();
+
+        unsigned int epochs = 0;
+        double updates_per_sec = 0;
+        double train_time = 0;
+        double accuracy = 0;
+        uvec predicted;
+
+        do
+        {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            updates_per_sec += logR.hogwild(Xt, d.Train_classIndices(), threads, 1);
+            train_time += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            epochs++;
+
+            //--Accuracy on the test set is evaluated outside the timed region--//
+            logR.classify(d.XTest(), predicted, NULL);
+            accuracy = ((double) accu(predicted == conv_to<uvec>::from(d.Test_classIndices()))) / d.testSize();
+
+        }while(accuracy < HOGWILD_TARGET_ACCURACY && epochs < HOGWILD_MAX_EPOCHS);
+
+        cout << threads << "  " << (updates_per_sec / epochs) << "  " << epochs << "  "
+             << train_time << "  " << accuracy << endl;
+    }
+}
+
+void hyperparameter_search(char* fileName=NULL, const bool MNIST=false)
+{
+    char* dataFileName;
+
+    if(fileName != NULL)
+    {
+        dataFileName = fileName;
+    }
+    else
+    {
+        dataFileName = "../Data/chip.dat";
+    }
+
+    //--Loaded once with degree 1; the search maps and caches each candidate degree itself--//
+    DataSet d(dataFileName, 1, TRAIN_PERCENT, TEST_PERCENT, MNIST, STRATIFY);
+
+    HyperparameterSearch search(d, "Classification");
+
+    vec alphas = {0.001, 0.01, 0.1, 1.0};
+    vec lamdas = {0.0, 0.1, 1.0, 10.0};
+
+    uvec degrees = regspace<uvec>(1, DEGREE);
+
+    search.gridSearch(alphas, lamdas, degrees);
+
+    unsigned int threads = thread::hardware_concurrency();
+    if(!threads)
+    {
+        threads = 1;
+    }
+
+    search.run(DELTA, SEARCH_MIN_ITERATIONS, MAX_ITERATIONS, SEARCH_ETA, threads);
+}
+
+void latency_benchmark(char* fileName=NULL, const bool MNIST=false)
+{
+    char* dataFileName;
+
+    if(fileName != NULL)
+    {
+        dataFileName = fileName;
+    }
+    else
+    {
+        dataFileName = "../Data/chip.dat";
+    }
+
+    DataSet d(dataFileName, DEGREE, TRAIN_PERCENT, TEST_PERCENT, MNIST, STRATIFY);
+
+    LogisticRegression logR(d);
+
+    logR.set_lamda(LAMDA);
+    logR.set_alpha(ALPHA);
+
+    if(MNIST)
+    {
+        logR.gradientdescent(d.XTrainQuantized(), d.Train_classIndices(), DELTA, MAX_ITERATIONS);
+    }
+    else
+    {
+        logR.gradientdescent(d.X(), d.classIndices(), d.trainRows(), DELTA, MAX_ITERATIONS);
+    }
+
+    Predictor predictor(d, logR);
+
+    //--Raw instances as a caller would hand them in, paired with their mapped and normalized rows--//
+    mat X_raw = MNIST ? conv_to<mat>::from(d.XTestQuantized().values()) : d.rawX();
+    mat X = MNIST ? d.XTest() : d.X();
+
+    vec h(predictor.K());
+    double max_error = 0;
+
+    for(unsigned int i=0; i<X.n_rows; i++)
+    {
+        vec x_raw = X_raw.row(i).t();
+        predictor.predict(x_raw.memptr(), h.memptr());
+
+        double error = norm(h - logR.h_Theta(X.row(i).t()), "inf");
+        max_error = (error > max_error) ? error : max_error;
+    }
+
+    cout << endl << "Predictor max |h - h_Theta|: " << max_error << endl;
+
+    //--Round trip through the model file: the inference library serves it without any training code--//
+    predictor.save(MODEL_FILE);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    InferenceModel model(MODEL_FILE);
+    double load_time = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+    vec h_model(model.K());
+    max_error = 0;
+
+    for(unsigned int i=0; i<X_raw.n_rows; i++)
+    {
+        vec x_raw = X_raw.row(i).t();
+        predictor.predict(x_raw.memptr(), h.memptr());
+        model.predict(x_raw.memptr(), h_model.memptr());
+
+        double error = norm(h - h_model, "inf");
+        max_error = (error > max_error) ? error : max_error;
+    }
+
+    cout << "Model file: " << MODEL_FILE << ", load(us): " << load_time << ", max |h - h_Predictor|: " << max_error << endl;
+
+    predictor.benchmark(X_raw, LATENCY_REPEATS);
+}
+
+void inference_server(char* fileName=NULL)
+{
+    //--Serves a model file written by -LATENCY, until the load generator stops it--//
+    string modelFileName = (fileName != NULL) ? fileName : MODEL_FILE;
+
+    InferenceServer server(modelFileName, SERVER_WINDOW);
+    server.serve(SERVER_SOCKET);
+}
+
+void load_generator(char* fileName=NULL)
+{
+    string modelFileName = (fileName != NULL) ? fileName : MODEL_FILE;
+
+    vector<unsigned int> windows = {0, 50, 100, 200, 500, 1000, 2000};
+
+    LoadGenerator generator(SERVER_SOCKET, modelFileName);
+    generator.run(windows, LOADGEN_CLIENTS, LOADGEN_SECONDS);
+    generator.stop();
+}
+
+void streaming_score(char* fileName=NULL)
+{
+    char* dataFileName;
+
+    if(fileName != NULL)
+    {
+        dataFileName = fileName;
+    }
+    else
+    {
+        dataFileName = "../Data/chip.dat";
+    }
+
+    StreamingScorer scorer(MODEL_FILE);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    unsigned long instances = scorer.score(dataFileName, SCORES_FILE);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << endl << "Scored " << instances << " instances of " << dataFileName << " into " << SCORES_FILE
+         << " in " << seconds << "s (" << (instances / seconds) << " instances/s)" << endl;
+}
+
+void int8_benchmark(char* fileName=NULL, const bool MNIST=false)
+{
+    char* dataFileName;
+
+    if(fileName != NULL)
+    {
+        dataFileName = fileName;
+    }
+    else
+    {
+        dataFileName = "../Data/chip.dat";
+    }
+
+    DataSet d(dataFileName, DEGREE, TRAIN_PERCENT, TEST_PERCENT, MNIST, STRATIFY);
+
+    LogisticRegression logR(d);
+
+    logR.set_lamda(LAMDA);
+    logR.set_alpha(ALPHA);
+
+    mat X_calibration;
+    mat X_test;
+    uvec actual;
+
+    if(MNIST)
+    {
+        logR.gradientdescent(d.XTrainQuantized(), d.Train_classIndices(), DELTA, MAX_ITERATIONS);
+
+        X_calibration = conv_to<mat>::from(d.XTrainQuantized().values());
+        X_test = conv_to<mat>::from(d.XTestQuantized().values());
+        actual = conv_to<uvec>::from(d.Test_classIndices());
+    }
+    else
+    {
+        logR.gradientdescent(d.X(), d.classIndices(), d.trainRows(), DELTA, MAX_ITERATIONS);
+
+        X_calibration = d.rawX().rows(d.trainRows());
+        X_test = d.rawX().rows(d.testRows());
+        actual = conv_to<uvec>::from(d.Test_classIndices());
+    }
+
+    Predictor predictor(d, logR);
+    QuantizedPredictor quantized(predictor, X_calibration);
+
+    quantized.evaluate(predictor, X_test, actual, INT8_REPEATS);
+}
+
 int main(int argc, char* argv[])
 {
     //--Initializing random seed--//
@@ -77,6 +483,18 @@ int main(int argc, char* argv[])
     char* dataFileName;
     fstream dataFile;
     bool MNIST = false;
+    bool HOGWILD = false;
+    bool CV = false;
+    bool METRICS = false;
+    bool RESUME = false;
+    bool OVR = false;
+    bool SEARCH = false;
+    bool SIMDBENCH = false;
+    bool LATENCY = false;
+    bool SERVE = false;
+    bool LOADGEN = false;
+    bool SCORE = false;
+    bool INT8 = false;
 
     if(argc >= 2)
     {
@@ -94,9 +512,60 @@ int main(int argc, char* argv[])
         }
         dataFile.close();
 
-        if(!strcmp(argv[2], "-MNIST"))
+        for(int a=2; a<argc; a++)
         {
-            MNIST = true;
+            if(!strcmp(argv[a], "-MNIST"))
+            {
+                MNIST = true;
+            }
+            else if(!strcmp(argv[a], "-HOGWILD"))
+            {
+                HOGWILD = true;
+            }
+            else if(!strcmp(argv[a], "-CV"))
+            {
+                CV = true;
+            }
+            else if(!strcmp(argv[a], "-METRICS"))
+            {
+                METRICS = true;
+            }
+            else if(!strcmp(argv[a], "-RESUME"))
+            {
+                RESUME = true;
+            }
+            else if(!strcmp(argv[a], "-OVR"))
+            {
+                OVR = true;
+            }
+            else if(!strcmp(argv[a], "-SEARCH"))
+            {
+                SEARCH = true;
+            }
+            else if(!strcmp(argv[a], "-SIMDBENCH"))
+            {
+                SIMDBENCH = true;
+            }
+            else if(!strcmp(argv[a], "-LATENCY"))
+            {
+                LATENCY = true;
+            }
+            else if(!strcmp(argv[a], "-SERVE"))
+            {
+                SERVE = true;
+            }
+            else if(!strcmp(argv[a], "-LOADGEN"))
+            {
+                LOADGEN = true;
+            }
+            else if(!strcmp(argv[a], "-SCORE"))
+            {
+                SCORE = true;
+            }
+            else if(!strcmp(argv[a], "-INT8"))
+            {
+                INT8 = true;
+            }
         }
     }
     else
@@ -105,7 +574,50 @@ int main(int argc, char* argv[])
     }
 
     //linear_regression(dataFileName);
-    logistic_regression(dataFileName, MNIST);
+    if(SIMDBENCH)
+    {
+        SimdMath::benchmark(SIMD_BENCHMARK_ELEMENTS, SIMD_BENCHMARK_REPEATS);
+    }
+    else if(SERVE)
+    {
+        inference_server(dataFileName);
+    }
+    else if(LOADGEN)
+    {
+        load_generator(dataFileName);
+    }
+    else if(INT8)
+    {
+        int8_benchmark(dataFileName, MNIST);
+    }
+    else if(SCORE)
+    {
+        streaming_score(dataFileName);
+    }
+    else if(LATENCY)
+    {
+        latency_benchmark(dataFileName, MNIST);
+    }
+    else if(HOGWILD)
+    {
+        hogwild_benchmark(dataFileName, MNIST);
+    }
+    else if(CV)
+    {
+        cross_validation(dataFileName, MNIST);
+    }
+    else if(OVR)
+    {
+        one_vs_rest(dataFileName, MNIST);
+    }
+    else if(SEARCH)
+    {
+        hyperparameter_search(dataFileName, MNIST);
+    }
+    else
+    {
+        logistic_regression(dataFileName, MNIST, METRICS, RESUME);
+    }
 
     return 0;
 }
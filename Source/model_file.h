@@ -0,0 +1,230 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   M O D E L   F I L E   H E A D E R                                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef MODEL_FILE_H
+#define MODEL_FILE_H
+
+#include<math.h>
+#include<stdint.h>
+#include<stddef.h>
+
+#define MODEL_FILE_MAGIC "RGMD"
+#define MODEL_FILE_VERSION 1
+#define MODEL_FILE_BYTE_ORDER 0x01020304    //--Reads back differently on a host of the other endianness--//
+#define MODEL_FILE_ALIGNMENT 64             //--Cache line size; every section starts on one--//
+
+//--Image of a frozen model, identical in memory and on disk so that it can be used straight from mmap:--//
+//--the header, then each section at the byte offset the header records, padded to a cache line.      --//
+//--Feature f = ∏ x_c^p over the terms [plan_offset[f], plan_offset[f+1]) of the exponent plan, and Ө --//
+//--is stored feature-major: the K weights of a feature are contiguous, bias first.                   --//
+
+enum ModelLink{ModelIdentity, ModelSigmoid, ModelSoftmax};
+
+struct ModelFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t attributes;        //--Raw attributes per instance--//
+    uint32_t features;          //--Mapped features per instance--//
+    uint32_t classes;           //--Outputs per instance, K--//
+    uint32_t terms;             //--Non-zero exponents in the plan--//
+    uint32_t degree;            //--Polynomial degree of the mapping--//
+    uint32_t link;              //--ModelLink--//
+    uint32_t labels;            //--Class labels; 0 for regression--//
+
+    //--Byte offsets from the start of the image--//
+    uint64_t mu;                //--double[features]--//
+    uint64_t inv_sigma;         //--double[features]--//
+    uint64_t theta;             //--double[(features + 1) * classes]--//
+    uint64_t plan_offset;       //--uint32_t[features + 1]--//
+    uint64_t plan_attribute;    //--uint32_t[terms]--//
+    uint64_t plan_power;        //--uint32_t[terms]--//
+    uint64_t label;             //--double[labels]--//
+    uint64_t bytes;             //--Size of the whole image--//
+};
+
+//--Read-only view of the sections of an image--//
+struct FrozenModel
+{
+    uint32_t attributes;
+    uint32_t features;
+    uint32_t classes;
+    uint32_t link;
+    bool identity;              //--Features are the raw attributes, in order: the exponent plan is skipped--//
+
+    const double* mu;
+    const double* inv_sigma;
+    const double* theta;
+    const uint32_t* plan_offset;
+    const uint32_t* plan_attribute;
+    const uint32_t* plan_power;
+    const double* label;
+};
+
+inline uint64_t modelFileAligned(const uint64_t bytes)
+{
+    return ((bytes + MODEL_FILE_ALIGNMENT - 1) / MODEL_FILE_ALIGNMENT) * MODEL_FILE_ALIGNMENT;
+}
+
+//--Lays the sections out behind the header from its counts, and returns the size of the image--//
+inline uint64_t modelFileLayout(ModelFileHeader& h)
+{
+    uint64_t at = modelFileAligned(sizeof(ModelFileHeader));
+
+    h.mu = at;
+    at += modelFileAligned(h.features * sizeof(double));
+    h.inv_sigma = at;
+    at += modelFileAligned(h.features * sizeof(double));
+    h.theta = at;
+    at += modelFileAligned((uint64_t) (h.features + 1) * h.classes * sizeof(double));
+    h.plan_offset = at;
+    at += modelFileAligned((h.features + 1) * sizeof(uint32_t));
+    h.plan_attribute = at;
+    at += modelFileAligned(h.terms * sizeof(uint32_t));
+    h.plan_power = at;
+    at += modelFileAligned(h.terms * sizeof(uint32_t));
+    h.label = at;
+    at += modelFileAligned(h.labels * sizeof(double));
+
+    h.bytes = at;
+    return at;
+}
+
+//--Points a view at the sections of an image whose header has been validated--//
+inline FrozenModel frozenModel(const void* image)
+{
+    const char* base = (const char*) image;
+    const ModelFileHeader* h = (const ModelFileHeader*) image;
+
+    FrozenModel m;
+
+    m.attributes = h->attributes;
+    m.features = h->features;
+    m.classes = h->classes;
+    m.link = h->link;
+
+    m.mu = (const double*) (base + h->mu);
+    m.inv_sigma = (const double*) (base + h->inv_sigma);
+    m.theta = (const double*) (base + h->theta);
+    m.plan_offset = (const uint32_t*) (base + h->plan_offset);
+    m.plan_attribute = (const uint32_t*) (base + h->plan_attribute);
+    m.plan_power = (const uint32_t*) (base + h->plan_power);
+    m.label = (const double*) (base + h->label);
+
+    m.identity = (h->features == h->attributes && h->terms == h->features);
+
+    for(uint32_t f=0; m.identity && f<h->features; f++)
+    {
+        m.identity = (m.plan_offset[f] == f && m.plan_attribute[f] == f && m.plan_power[f] == 1);
+    }
+
+    return m;
+}
+
+//--Feature f of the raw instance x, mapped and normalized--//
+inline double frozenFeature(const FrozenModel& m, const double* x, const uint32_t f)
+{
+    double v;
+
+    if(m.identity)
+    {
+        v = x[f];
+    }
+    else
+    {
+        //--Exponents are small integers, so powers are products--//
+        v = 1.0;
+
+        for(uint32_t t=m.plan_offset[f]; t<m.plan_offset[f+1]; t++)
+        {
+            double a = x[m.plan_attribute[t]];
+
+            for(uint32_t p=0; p<m.plan_power[t]; p++)
+            {
+                v *= a;
+            }
+        }
+    }
+
+    return (v - m.mu[f]) * m.inv_sigma[f];
+}
+
+//--z = Ө'[1 x̂], with x̂ the raw instance x mapped and normalized, in one pass over the features--//
+inline void frozenLogits(const FrozenModel& m, const double* x, double* z)
+{
+    for(uint32_t k=0; k<m.classes; k++)
+    {
+        z[k] = m.theta[k];
+    }
+
+    for(uint32_t f=0; f<m.features; f++)
+    {
+        double v = frozenFeature(m, x, f);
+        const double* w = m.theta + ((uint64_t) (f + 1) * m.classes);
+
+        for(uint32_t k=0; k<m.classes; k++)
+        {
+            z[k] += w[k] * v;
+        }
+    }
+}
+
+//--h = g(z) in place, over the K logits of a single instance--//
+inline void frozenLink(const uint32_t link, double* z, const uint32_t classes)
+{
+    if(link == ModelSigmoid)
+    {
+        for(uint32_t k=0; k<classes; k++)
+        {
+            z[k] = 1.0 / (1.0 + exp(-z[k]));
+        }
+    }
+    else if(link == ModelSoftmax)
+    {
+        double z_max = z[0];
+        for(uint32_t k=1; k<classes; k++)
+        {
+            z_max = (z[k] > z_max) ? z[k] : z_max;
+        }
+
+        double sum_exp = 0;
+        for(uint32_t k=0; k<classes; k++)
+        {
+            z[k] = exp(z[k] - z_max);
+            sum_exp += z[k];
+        }
+
+        for(uint32_t k=0; k<classes; k++)
+        {
+            z[k] /= sum_exp;
+        }
+    }
+}
+
+//--Index of the largest of the K logits; the links are monotone, so it is also the predicted class--//
+inline uint32_t frozenArgmax(const double* z, const uint32_t classes)
+{
+    uint32_t best = 0;
+
+    for(uint32_t k=1; k<classes; k++)
+    {
+        best = (z[k] > z[best]) ? k : best;
+    }
+
+    return best;
+}
+
+#endif // MODEL_FILE_H
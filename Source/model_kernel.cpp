@@ -0,0 +1,158 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   M O D E L   K E R N E L                                                                */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "model_kernel.h"
+
+#include<string.h>
+
+// double crossEntropy(mat&, const mat*, const uvec*, const bool, const bool) method
+
+/// Fused, numerically stable softmax and cross-entropy over a tile of logits.
+/// @param Z MxK logits, overwritten with softmax(Z), or with softmax(Z) - Y' when residual is set.
+/// @param Y Targets, or NULL to only apply the softmax.
+/// @param rows Rows of Y paired with the rows of Z, or NULL when row t of Z is instance t.
+/// @param indexed Indicates if Y is an Mx1 vector of class indices rather than a KxM one-hot matrix.
+/// @param residual Indicates if Y' is to be subtracted from softmax(Z).
+
+double SoftmaxLink::crossEntropy(mat& Z, const mat* Y, const uvec* rows, const bool indexed, const bool residual)
+{
+    //--Rows are taken in chunks whose per-row state lives on the stack, so nothing is allocated on the heap,  --//
+    //--and within a chunk every column segment is swept contiguously.                                         --//
+
+    uword m = Z.n_rows;
+    uword classes = Z.n_cols;
+
+    double z_max[SOFTMAX_CHUNK];
+    double sum_exp[SOFTMAX_CHUNK];
+    double y_sum[SOFTMAX_CHUNK];
+
+    double loss = 0;
+
+    for(uword first=0; first<m; first+=SOFTMAX_CHUNK)
+    {
+        uword rows_in_chunk = (first + SOFTMAX_CHUNK < m) ? SOFTMAX_CHUNK : (m - first);
+
+        memcpy(z_max, Z.colptr(0) + first, rows_in_chunk * sizeof(double));
+
+        for(uword k=1; k<classes; k++)
+        {
+            const double* z = Z.colptr(k) + first;
+
+            for(uword t=0; t<rows_in_chunk; t++)
+            {
+                z_max[t] = (z[t] > z_max[t]) ? z[t] : z_max[t];
+            }
+        }
+
+        //--The target term ∑ y (z - max) is taken before the logits are overwritten, so log(p) is never formed--//
+        if(Y != NULL && indexed)
+        {
+            for(uword t=0; t<rows_in_chunk; t++)
+            {
+                uword k = (uword) (*Y)((rows != NULL) ? (*rows)(first + t) : (first + t));
+
+                loss -= Z(first + t, k) - z_max[t];
+                y_sum[t] = 1.0;
+            }
+        }
+        else if(Y != NULL)
+        {
+            for(uword t=0; t<rows_in_chunk; t++)
+            {
+                const double* y = Y->colptr((rows != NULL) ? (*rows)(first + t) : (first + t));
+                y_sum[t] = 0;
+
+                for(uword k=0; k<classes; k++)
+                {
+                    if(y[k] != 0.0)
+                    {
+                        loss -= y[k] * (Z(first + t, k) - z_max[t]);
+                        y_sum[t] += y[k];
+                    }
+                }
+            }
+        }
+
+        for(uword t=0; t<rows_in_chunk; t++)
+        {
+            sum_exp[t] = 0;
+        }
+
+        for(uword k=0; k<classes; k++)
+        {
+            double* z = Z.colptr(k) + first;
+
+            for(uword t=0; t<rows_in_chunk; t++)
+            {
+                z[t] -= z_max[t];
+            }
+
+            SimdMath::exp(z, rows_in_chunk);
+
+            for(uword t=0; t<rows_in_chunk; t++)
+            {
+                sum_exp[t] += z[t];
+            }
+        }
+
+        for(uword k=0; k<classes; k++)
+        {
+            double* z = Z.colptr(k) + first;
+
+            for(uword t=0; t<rows_in_chunk; t++)
+            {
+                z[t] /= sum_exp[t];
+            }
+        }
+
+        //--          m  K                                                   --//
+        //-- J_r(Ө) = ∑  ∑ -y_k [(z_k - max(z)) - log ∑_j e^(z_j - max(z))] --//
+        //--          i  k                                                   --//
+
+        if(Y != NULL)
+        {
+            SimdMath::log(sum_exp, rows_in_chunk);
+
+            for(uword t=0; t<rows_in_chunk; t++)
+            {
+                loss += y_sum[t] * sum_exp[t];
+            }
+        }
+
+        if(residual)
+        {
+            for(uword t=0; t<rows_in_chunk; t++)
+            {
+                uword i = (rows != NULL) ? (*rows)(first + t) : (first + t);
+
+                if(indexed)
+                {
+                    Z(first + t, (uword) (*Y)(i)) -= 1.0;
+                }
+                else
+                {
+                    const double* y = Y->colptr(i);
+
+                    for(uword k=0; k<classes; k++)
+                    {
+                        Z(first + t, k) -= y[k];
+                    }
+                }
+            }
+        }
+    }
+
+    return loss;
+}
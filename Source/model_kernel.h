@@ -0,0 +1,381 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   M O D E L   K E R N E L   H E A D E R                                                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef MODEL_KERNEL_H
+#define MODEL_KERNEL_H
+
+#include<math.h>
+#include<vector>
+#include<random>
+
+#include "armadillo"
+#include "simd_math.h"
+#include "model_file.h"
+
+using namespace std;
+using namespace arma;
+
+#define SOFTMAX_CHUNK 256
+
+//--A model is a link h = g(z), a loss on h and a regularizer on Ө, each a policy with static inline   --//
+//--members. ModelKernel<Link, Loss, Penalty> composes them at compile time, so in the per-row loops of --//
+//--SGD and single-row inference the three are inlined into one another with no dispatch in between.   --//
+//--Rows of a tile are strided: element k of row t of an MxK matrix is at t + k*M.                      --//
+
+//--Links--//
+
+struct IdentityLink
+{
+    static const ModelLink id = ModelIdentity;
+
+    static inline void row(double*, const uword, const uword) {}
+    static inline void tile(mat&) {}
+};
+
+struct SigmoidLink
+{
+    static const ModelLink id = ModelSigmoid;
+
+    static inline void row(double* z, const uword classes, const uword stride)
+    {
+        for(uword k=0; k<classes; k++)
+        {
+            z[k*stride] = 1.0 / (1.0 + exp(-z[k*stride]));
+        }
+    }
+
+    static inline void tile(mat& Z)
+    {
+        SimdMath::sigmoid(Z.memptr(), Z.n_elem);
+    }
+};
+
+struct SoftmaxLink
+{
+    static const ModelLink id = ModelSoftmax;
+
+    static inline void row(double* z, const uword classes, const uword stride)
+    {
+        double z_max = z[0];
+        for(uword k=1; k<classes; k++)
+        {
+            z_max = (z[k*stride] > z_max) ? z[k*stride] : z_max;
+        }
+
+        double sum_exp = 0;
+        for(uword k=0; k<classes; k++)
+        {
+            z[k*stride] = exp(z[k*stride] - z_max);
+            sum_exp += z[k*stride];
+        }
+
+        for(uword k=0; k<classes; k++)
+        {
+            z[k*stride] /= sum_exp;
+        }
+    }
+
+    static inline void tile(mat& Z)
+    {
+        crossEntropy(Z, NULL, NULL, false, false);
+    }
+
+    static double crossEntropy(mat&, const mat*, const uvec*, const bool, const bool);
+};
+
+//--Losses. residual() replaces h with ∂loss/∂z and returns the loss; gradient() skips the loss.--//
+//--Both are paired with their canonical link, so ∂loss/∂z = h - y.                             --//
+
+struct SquaredLoss
+{
+    //--½∑(h_k - y_k)^2, with Y an MxT matrix of targets--//
+    static inline double residual(double* h, const uword targets, const uword stride, const mat& Y, const uword i, const bool)
+    {
+        double loss = 0;
+
+        for(uword k=0; k<targets; k++)
+        {
+            double r = h[k*stride] - Y(i,k);
+
+            loss += 0.5 * r * r;
+            h[k*stride] = r;
+        }
+
+        return loss;
+    }
+
+    static inline void gradient(double* h, const uword targets, const uword stride, const mat& Y, const uword i, const bool)
+    {
+        for(uword k=0; k<targets; k++)
+        {
+            h[k*stride] -= Y(i,k);
+        }
+    }
+};
+
+struct CrossEntropyLoss
+{
+    //--∑ -y_k log(h_k), with Y a KxM one-hot matrix, or an Mx1 vector of class indices when indexed--//
+    static inline double residual(double* h, const uword classes, const uword stride, const mat& Y, const uword i, const bool indexed)
+    {
+        double loss = 0;
+
+        if(indexed)
+        {
+            double* h_k = h + ((uword) Y(i) * stride);
+
+            loss -= log(*h_k);
+            *h_k -= 1.0;
+
+            return loss;
+        }
+
+        const double* y = Y.colptr(i);
+
+        for(uword k=0; k<classes; k++)
+        {
+            if(y[k] != 0.0)
+            {
+                loss -= y[k] * log(h[k*stride]);
+                h[k*stride] -= y[k];
+            }
+        }
+
+        return loss;
+    }
+
+    static inline void gradient(double* h, const uword classes, const uword stride, const mat& Y, const uword i, const bool indexed)
+    {
+        if(indexed)
+        {
+            h[(uword) Y(i) * stride] -= 1.0;
+            return;
+        }
+
+        const double* y = Y.colptr(i);
+
+        for(uword k=0; k<classes; k++)
+        {
+            h[k*stride] -= y[k];
+        }
+    }
+};
+
+//--Regularizers. The bias row of Ө is never penalized.--//
+
+struct L2Penalty
+{
+    //--½λ∑(Ө_j)^2, ∀ j >= 1--//
+    static inline double cost(const mat& theta, const double lamda)
+    {
+        return 0.5 * lamda * accu(square(theta.rows(1, theta.n_rows-1)));
+    }
+
+    static inline void gradient(mat& G, const mat& theta, const double lamda)
+    {
+        G.rows(1, theta.n_rows-1) += lamda * theta.rows(1, theta.n_rows-1);
+    }
+
+    static inline double gradient(const double theta_j, const double lamda)
+    {
+        return lamda * theta_j;
+    }
+};
+
+//--Tile residual: the link over the whole tile, then the loss row by row. Softmax with cross-entropy--//
+//--is specialized to the fused, numerically stable kernel, which never forms log(h).                --//
+template<class Link, class Loss> struct TileResidual
+{
+    static inline double apply(mat& Z, const mat& Y, const uvec* rows, const bool indexed)
+    {
+        Link::tile(Z);
+
+        double loss = 0;
+
+        for(uword t=0; t<Z.n_rows; t++)
+        {
+            loss += Loss::residual(Z.memptr() + t, Z.n_cols, Z.n_rows, Y, (rows != NULL) ? (*rows)(t) : t, indexed);
+        }
+
+        return loss;
+    }
+};
+
+template<> struct TileResidual<SoftmaxLink, CrossEntropyLoss>
+{
+    static inline double apply(mat& Z, const mat& Y, const uvec* rows, const bool indexed)
+    {
+        return SoftmaxLink::crossEntropy(Z, &Y, rows, indexed, true);
+    }
+};
+
+//--Relaxed atomic access to shared Ө elements, used by the lock-free SGD workers--//
+inline double relaxedLoad(const double* p)
+{
+    double v;
+    __atomic_load(p, &v, __ATOMIC_RELAXED);
+    return v;
+}
+
+inline void relaxedStore(double* p, double v)
+{
+    __atomic_store(p, &v, __ATOMIC_RELAXED);
+}
+
+template<class Link, class Loss, class Penalty> struct ModelKernel
+{
+    //--h = g(Ө'[1 x]) for a single instance x of n attributes, into h of K elements--//
+    static void predict(const mat& theta, const double* x, double* h)
+    {
+        uword n = theta.n_rows - 1;
+
+        for(uword k=0; k<theta.n_cols; k++)
+        {
+            const double* theta_k = theta.colptr(k);
+            double z = theta_k[0];
+
+            for(uword j=0; j<n; j++)
+            {
+                z += theta_k[j+1] * x[j];
+            }
+
+            h[k] = z;
+        }
+
+        Link::row(h, theta.n_cols, 1);
+    }
+
+    //--h = g(z) in place, over a whole tile of logits--//
+    static void link(mat& Z)
+    {
+        Link::tile(Z);
+    }
+
+    //--Z holds XΘ; row t pairs with instance rows(t) of Y, or t when rows is NULL--//
+    static double residual(mat& Z, const mat& Y, const uvec* rows, const bool indexed)
+    {
+        return TileResidual<Link, Loss>::apply(Z, Y, rows, indexed);
+    }
+
+    //--J(Ө) for X with its bias column--//
+    static double cost(const mat& X, const mat& Y, const mat& theta, const double lamda, const bool indexed)
+    {
+        mat Z = X * theta;
+        double loss = residual(Z, Y, NULL, indexed);
+
+        return (loss + Penalty::cost(theta, lamda)) / X.n_rows;
+    }
+
+    //--∂J(Ө)/∂Ө, unscaled by 1/m, for X with its bias column--//
+    static mat derivative(const mat& X, const mat& Y, const mat& theta, const double lamda, const bool indexed)
+    {
+        mat r = X * theta;
+        residual(r, Y, NULL, indexed);
+
+        mat G = X.t() * r;
+        Penalty::gradient(G, theta, lamda);
+
+        return G;
+    }
+
+    //--Adds the penalty gradient to G and returns the penalty cost--//
+    static double penalty(mat& G, const mat& theta, const double lamda)
+    {
+        Penalty::gradient(G, theta, lamda);
+        return Penalty::cost(theta, lamda);
+    }
+
+    //--Hogwild SGD: samples instances of X' (one column per instance, non-zeros only) and updates the--//
+    //--touched Ө_jk without locks. Link, loss gradient and penalty are inlined into the update loop.  --//
+    static void sgd(const sp_mat& Xt, const mat& Y, mat& theta, const double alpha, const double lamda,
+                    const bool indexed, const unsigned int updates, const unsigned int seed)
+    {
+        unsigned int m = Xt.n_cols;
+        unsigned int rows = theta.n_rows;
+        unsigned int classes = theta.n_cols;
+        double* th = theta.memptr();
+        double decay = lamda / m;
+
+        vector<double> h(classes);
+
+        mt19937 rng(seed);
+        uniform_int_distribution<unsigned int> sample(0, m-1);
+
+        for(unsigned int u=0; u<updates; u++)
+        {
+            unsigned int i = sample(rng);
+            uword begin = Xt.col_ptrs[i];
+            uword end = Xt.col_ptrs[i+1];
+
+            //--z_k = Ө_0k + ∑ x_j Ө_jk, over the non-zero features of x⁽i⁾ only--//
+            for(unsigned int k=0; k<classes; k++)
+            {
+                const double* theta_k = th + (k * rows);
+                double z = relaxedLoad(theta_k);
+
+                for(uword p=begin; p<end; p++)
+                {
+                    z += Xt.values[p] * relaxedLoad(theta_k + Xt.row_indices[p] + 1);
+                }
+
+                h[k] = z;
+            }
+
+            Link::row(&h[0], classes, 1);
+            Loss::gradient(&h[0], classes, 1, Y, i, indexed);
+
+            //--Ө_jk := Ө_jk - 𝛼[r_k x_j + (λ/m)Ө_jk], applied to the touched Ө_jk only--//
+            for(unsigned int k=0; k<classes; k++)
+            {
+                double* theta_k = th + (k * rows);
+                double r = h[k];
+
+                relaxedStore(theta_k, relaxedLoad(theta_k) - (alpha * r));
+
+                for(uword p=begin; p<end; p++)
+                {
+                    double* w = theta_k + Xt.row_indices[p] + 1;
+                    double v = relaxedLoad(w);
+
+                    relaxedStore(w, v - (alpha * ((r * Xt.values[p]) + Penalty::gradient(v, decay))));
+                }
+            }
+        }
+    }
+};
+
+//--Entry points of one ModelKernel instantiation, held by a model so its hot loops call straight into--//
+//--the specialized code; the model's type is resolved once, when the table is built.                 --//
+struct ModelKernels
+{
+    void (*predict)(const mat&, const double*, double*);
+    void (*link)(mat&);
+    double (*residual)(mat&, const mat&, const uvec*, const bool);
+    double (*cost)(const mat&, const mat&, const mat&, const double, const bool);
+    mat (*derivative)(const mat&, const mat&, const mat&, const double, const bool);
+    double (*penalty)(mat&, const mat&, const double);
+    void (*sgd)(const sp_mat&, const mat&, mat&, const double, const double, const bool, const unsigned int, const unsigned int);
+    ModelLink link_id;      //--Link as recorded in a model file--//
+};
+
+template<class Link, class Loss, class Penalty> ModelKernels makeModelKernels(void)
+{
+    typedef ModelKernel<Link, Loss, Penalty> K;
+
+    ModelKernels kernels = {&K::predict, &K::link, &K::residual, &K::cost, &K::derivative, &K::penalty, &K::sgd, Link::id};
+    return kernels;
+}
+
+#endif // MODEL_KERNEL_H
@@ -0,0 +1,299 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   P R E D I C T O R   C L A S S                                                          */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "predictor.h"
+
+#include<stdlib.h>
+#include<string.h>
+#include<fstream>
+#include<algorithm>
+#include<chrono>
+#include<vector>
+
+// CONSTRUCTOR
+
+/// Freezes a trained model together with the feature mapping and normalization of its data set.
+/// Later changes to the model or the data set do not affect the predictor.
+/// @param d Data set the model was trained on.
+/// @param model Trained model.
+
+Predictor::Predictor(const DataSet& d, const Regression& model)
+{
+    mat E = d.featureExponents();
+    mat theta = model.theta();
+    vec mu = d.Mean();
+    vec sigma = d.STDEV();
+
+    if(E.n_rows != theta.n_rows-1 || mu.n_rows != E.n_rows || sigma.n_rows != E.n_rows)
+    {
+        cerr << "Regression: Predictor class." << endl
+             << "Predictor(const DataSet&, const Regression&) constructor." << endl
+             << "Features of the data set: " << E.n_rows << ", Mu: " << mu.n_rows << ", Sigma: " << sigma.n_rows
+             << " and row size of Theta: " << theta.n_rows << " are incompatable."
+             << endl;
+
+        exit(1);
+    }
+
+    //--Class labels are kept for classifiers only; a regression model's outputs are its predictions--//
+    vec labels;
+    if(model.kernels().link_id != ModelIdentity)
+    {
+        labels = d.labels();
+    }
+
+    ModelFileHeader header;
+
+    memcpy(header.magic, MODEL_FILE_MAGIC, sizeof(header.magic));
+    header.version = MODEL_FILE_VERSION;
+    header.byte_order = MODEL_FILE_BYTE_ORDER;
+    header.attributes = E.n_cols;
+    header.features = E.n_rows;
+    header.classes = theta.n_cols;
+    header.terms = accu(E != 0.0);
+    header.degree = d.degree();
+    header.link = model.kernels().link_id;
+    header.labels = labels.n_rows;
+
+    uint64_t bytes = modelFileLayout(header);
+
+    if(posix_memalign(&d_block, MODEL_FILE_ALIGNMENT, bytes))
+    {
+        cerr << "Regression: Predictor class." << endl
+             << "Predictor(const DataSet&, const Regression&) constructor." << endl
+             << "Cannot allocate the frozen model."
+             << endl;
+
+        exit(1);
+    }
+
+    //--Padding is zeroed too, so that saved images are reproducible byte for byte--//
+    char* base = (char*) d_block;
+    memset(base, 0, bytes);
+    memcpy(base, &header, sizeof(header));
+
+    double* mu_s = (double*) (base + header.mu);
+    double* inv_sigma_s = (double*) (base + header.inv_sigma);
+    double* theta_s = (double*) (base + header.theta);
+    uint32_t* offset_s = (uint32_t*) (base + header.plan_offset);
+    uint32_t* attribute_s = (uint32_t*) (base + header.plan_attribute);
+    uint32_t* power_s = (uint32_t*) (base + header.plan_power);
+    double* label_s = (double*) (base + header.label);
+
+    for(uword f=0; f<E.n_rows; f++)
+    {
+        mu_s[f] = mu(f);
+        inv_sigma_s[f] = 1.0 / sigma(f);
+    }
+
+    for(uword f=0; f<theta.n_rows; f++)
+    {
+        for(uword k=0; k<theta.n_cols; k++)
+        {
+            theta_s[(f * theta.n_cols) + k] = theta(f,k);
+        }
+    }
+
+    //--The plan keeps only the non-zero exponents of each feature--//
+    uint32_t t = 0;
+
+    for(uword f=0; f<E.n_rows; f++)
+    {
+        offset_s[f] = t;
+
+        for(uword c=0; c<E.n_cols; c++)
+        {
+            if(E(f,c) != 0.0)
+            {
+                attribute_s[t] = c;
+                power_s[t] = (uint32_t) E(f,c);
+                t++;
+            }
+        }
+    }
+    offset_s[E.n_rows] = t;
+
+    for(uword l=0; l<labels.n_rows; l++)
+    {
+        label_s[l] = labels(l);
+    }
+
+    d_model = frozenModel(d_block);
+}
+
+
+// DESTRUCTOR
+
+/// Releases the frozen model.
+
+Predictor::~Predictor()
+{
+    free(d_block);
+}
+
+
+// unsigned int N(void) const method
+
+/// Returns the number of raw attributes of an instance.
+
+unsigned int Predictor::N(void) const
+{
+    return d_model.attributes;
+}
+
+
+// unsigned int K(void) const method
+
+/// Returns the number of outputs of a prediction.
+
+unsigned int Predictor::K(void) const
+{
+    return d_model.classes;
+}
+
+
+// unsigned int features(void) const method
+
+/// Returns the number of features an instance is mapped to.
+
+unsigned int Predictor::features(void) const
+{
+    return d_model.features;
+}
+
+
+// const FrozenModel& frozen(void) const method
+
+/// Returns the view of the frozen model's sections, valid for the lifetime of the predictor.
+
+const FrozenModel& Predictor::frozen(void) const
+{
+    return d_model;
+}
+
+
+// void predict(const double*, double*) const method
+
+/// Returns h_Ө(x) for a raw instance, as the model would for the mapped and normalized instance. Does not allocate.
+/// @param x Raw instance of N() attributes.
+/// @param h Buffer of K() doubles to hold the prediction.
+
+void Predictor::predict(const double* x, double* h) const
+{
+    frozenLogits(d_model, x, h);
+    frozenLink(d_model.link, h, d_model.classes);
+}
+
+
+// uword classify(const double*, double*) const method
+
+/// Returns the predicted class of a raw instance: the arg max of its logits, since the link is monotone. Does not allocate.
+/// @param x Raw instance of N() attributes.
+/// @param z Buffer of K() doubles, left holding the logits.
+
+uword Predictor::classify(const double* x, double* z) const
+{
+    frozenLogits(d_model, x, z);
+    return frozenArgmax(z, d_model.classes);
+}
+
+
+// void save(const string&) const method
+
+/// Writes the frozen model to a model file, which InferenceModel maps back without any training code.
+/// The file is in the byte order of this host, and is rejected on load by a host of the other one.
+/// @param fileName Path of the model file.
+
+void Predictor::save(const string& fileName) const
+{
+    const ModelFileHeader* header = (const ModelFileHeader*) d_block;
+
+    fstream file;
+    file.open(fileName.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+    file.write((const char*) d_block, header->bytes);
+    file.close();
+
+    if(file.fail())
+    {
+        cerr << "Regression: Predictor class." << endl
+             << "void save(const string&) const method." << endl
+             << "Cannot write model file: " << fileName
+             << endl;
+
+        exit(1);
+    }
+}
+
+
+// void benchmark(const mat&, const unsigned int) const method
+
+/// Prints the p50 and p99 latency of predict(), timed one call at a time, and the mean latency over untimed back-to-back calls.
+/// @param X Raw instances, one per row.
+/// @param repeats Number of passes over the instances > 0.
+
+void Predictor::benchmark(const mat& X, const unsigned int repeats) const
+{
+    if(X.n_cols != d_model.attributes || !X.n_rows || !repeats)
+    {
+        cerr << "Regression: Predictor class." << endl
+             << "void benchmark(const mat&, const unsigned int) const method." << endl
+             << "Matrix X: " << X.n_rows << "x" << X.n_cols << " must be non-empty with " << d_model.attributes
+             << " colums, and repeats: " << repeats << " must be > 0."
+             << endl;
+
+        exit(1);
+    }
+
+    //--One raw instance per column, so each is a contiguous array as a caller would hand it in--//
+    mat Xt = X.t();
+    uword m = Xt.n_cols;
+
+    vector<double> h(d_model.classes);
+    vector<double> latency(m * repeats);
+
+    for(uword i=0; i<m; i++)
+    {
+        predict(Xt.colptr(i), &h[0]);
+    }
+
+    for(unsigned int r=0; r<repeats; r++)
+    {
+        for(uword i=0; i<m; i++)
+        {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            predict(Xt.colptr(i), &h[0]);
+            latency[(r * m) + i] = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for(unsigned int r=0; r<repeats; r++)
+    {
+        for(uword i=0; i<m; i++)
+        {
+            predict(Xt.colptr(i), &h[0]);
+        }
+    }
+
+    double mean = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / latency.size();
+
+    sort(latency.begin(), latency.end());
+
+    cout << endl << "Single-instance prediction latency (" << latency.size() << " calls, " << d_model.attributes << " attributes, "
+         << d_model.features << " features, " << d_model.classes << " outputs)"
+         << endl << "#p50(ns)  #p99(ns)  #Mean(ns)" << endl
+         << latency[latency.size() / 2] << "  " << latency[(latency.size() * 99) / 100] << "  " << mean << endl;
+}
@@ -0,0 +1,59 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   P R E D I C T O R   C L A S S   H E A D E R                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef PREDICTOR_H
+#define PREDICTOR_H
+
+#include<iostream>
+#include<stdint.h>
+
+#include "armadillo"
+#include "dataset.h"
+#include "regression.h"
+#include "model_file.h"
+
+using namespace std;
+using namespace arma;
+
+//--A trained model frozen for serving one raw instance at a time: feature mapping, normalization, Ө'x--//
+//--and the link, out of a single cache-aligned block and without touching the heap. The block is the  --//
+//--model file image, so save() writes it as it is and InferenceModel serves it back from mmap.        --//
+class Predictor
+{
+public:
+    Predictor(const DataSet&, const Regression&);
+    ~Predictor();
+
+    Predictor(const Predictor&) = delete;
+    Predictor& operator=(const Predictor&) = delete;
+
+    unsigned int N(void) const;
+    unsigned int K(void) const;
+    unsigned int features(void) const;
+    const FrozenModel& frozen(void) const;
+
+    void predict(const double*, double*) const;
+    uword classify(const double*, double*) const;
+
+    void save(const string&) const;
+
+    void benchmark(const mat&, const unsigned int) const;
+
+private:
+    void* d_block;                  //--Model file image: ModelFileHeader, then its sections--//
+    FrozenModel d_model;            //--View of the sections of d_block--//
+};
+
+#endif // PREDICTOR_H
@@ -0,0 +1,141 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   Q U A N T I Z E D   M A T R I X   C L A S S                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "quantized_matrix.h"
+
+// DEFAULT CONSTRUCTOR
+
+/// Creates an empty quantized matrix.
+
+QuantizedMatrix::QuantizedMatrix()
+{
+    d_scale = 1.0;
+    d_offset = 0.0;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a quantized matrix from raw 8-bit values, which are dequantized as scale * q + offset.
+/// @param values Matrix of 8-bit values, were each row is an instance and each column is an attribute.
+/// @param scale Step between two consecutive quantization levels, > 0.
+/// @param offset Value represented by level 0.
+
+QuantizedMatrix::QuantizedMatrix(const Mat<unsigned char>& values, const double scale, const double offset):d_values(values)
+{
+    if(scale <= 0.0)
+    {
+        cerr << "Regression: QuantizedMatrix class." << endl
+             << "QuantizedMatrix(const Mat<unsigned char>&, const double, const double) constructor." << endl
+             << "Scale: " << scale << " must be > 0."
+             << endl;
+
+        exit(1);
+    }
+
+    d_scale = scale;
+    d_offset = offset;
+}
+
+
+// unsigned int M(void) const method
+
+/// Returns the number of instances (rows) of the matrix.
+
+unsigned int QuantizedMatrix::M(void) const
+{
+    return d_values.n_rows;
+}
+
+
+// unsigned int N(void) const method
+
+/// Returns the number of attributes (columns) of the matrix.
+
+unsigned int QuantizedMatrix::N(void) const
+{
+    return d_values.n_cols;
+}
+
+
+// bool is_empty(void) const method
+
+/// Returns true if the matrix holds no values.
+
+bool QuantizedMatrix::is_empty(void) const
+{
+    return d_values.is_empty();
+}
+
+
+// const Mat<unsigned char>& values(void) const method
+
+/// Returns a reference to the raw 8-bit values, stored column by column like Armadillo::mat.
+
+const Mat<unsigned char>& QuantizedMatrix::values(void) const
+{
+    return d_values;
+}
+
+
+// double scale(void) const method
+
+/// Returns the step between two consecutive quantization levels.
+
+double QuantizedMatrix::scale(void) const
+{
+    return d_scale;
+}
+
+
+// double offset(void) const method
+
+/// Returns the value represented by quantization level 0.
+
+double QuantizedMatrix::offset(void) const
+{
+    return d_offset;
+}
+
+
+// mat dequantize(void) const method
+
+/// Returns the whole matrix in double precision. Training streams tiles through DataView instead;
+/// this is meant for code paths that need a dense Armadillo::mat.
+
+mat QuantizedMatrix::dequantize(void) const
+{
+    mat X(d_values.n_rows, d_values.n_cols);
+
+    const unsigned char* q = d_values.memptr();
+    double* x = X.memptr();
+
+    for(uword i=0; i<X.n_elem; i++)
+    {
+        x[i] = d_scale * q[i] + d_offset;
+    }
+
+    return X;
+}
+
+
+// uword memoryBytes(void) const method
+
+/// Returns the number of bytes held by the raw values.
+
+uword QuantizedMatrix::memoryBytes(void) const
+{
+    return d_values.n_elem * sizeof(unsigned char);
+}
@@ -0,0 +1,51 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   Q U A N T I Z E D   M A T R I X   C L A S S   H E A D E R                              */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef QUANTIZED_MATRIX_H
+#define QUANTIZED_MATRIX_H
+
+#include<iostream>
+
+#include "armadillo"
+
+using namespace std;
+using namespace arma;
+
+//--8-bit design matrix: x(i,j) = scale * q(i,j) + offset, with one scale and offset for the whole matrix--//
+class QuantizedMatrix
+{
+public:
+    QuantizedMatrix();
+    QuantizedMatrix(const Mat<unsigned char>&, const double, const double);
+
+    unsigned int M(void) const;
+    unsigned int N(void) const;
+    bool is_empty(void) const;
+
+    const Mat<unsigned char>& values(void) const;
+    double scale(void) const;
+    double offset(void) const;
+
+    mat dequantize(void) const;
+    uword memoryBytes(void) const;
+
+private:
+    Mat<unsigned char> d_values;
+
+    double d_scale;
+    double d_offset;
+};
+
+#endif // QUANTIZED_MATRIX_H
@@ -0,0 +1,316 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   Q U A N T I Z E D   P R E D I C T O R   C L A S S                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "quantized_predictor.h"
+#include "simd_math.h"
+
+#include<math.h>
+#include<stdlib.h>
+#include<string.h>
+#include<chrono>
+#include<vector>
+
+static int8_t toInt8(const double v)
+{
+    long q = lrint(v);
+
+    return (int8_t) ((q > INT8_LEVELS) ? INT8_LEVELS : ((q < -INT8_LEVELS) ? -INT8_LEVELS : q));
+}
+
+
+// CONSTRUCTOR
+
+/// Quantizes a frozen classifier, calibrating the int8 step of each feature on a sample of raw instances.
+/// Inputs beyond the calibrated range saturate at ±127.
+/// @param p Frozen classifier.
+/// @param X Raw calibration instances, one per row, e.g. the training set.
+
+QuantizedPredictor::QuantizedPredictor(const Predictor& p, const mat& X)
+{
+    const FrozenModel& m = p.frozen();
+
+    if(m.link == ModelIdentity || X.n_cols != m.attributes || !X.n_rows)
+    {
+        cerr << "Regression: QuantizedPredictor class." << endl
+             << "QuantizedPredictor(const Predictor&, const mat&) constructor." << endl
+             << "The model must be a classifier, and matrix X: " << X.n_rows << "x" << X.n_cols
+             << " must be non-empty with " << m.attributes << " colums."
+             << endl;
+
+        exit(1);
+    }
+
+    uint32_t F = m.features;
+    uint32_t K = m.classes;
+    uint32_t T = m.plan_offset[F];
+
+    d_width = ((F + INT8_WIDTH_MULTIPLE - 1) / INT8_WIDTH_MULTIPLE) * INT8_WIDTH_MULTIPLE;
+
+    //--a_f = max|x̂_f| / 127 over the calibration instances; a feature that is always 0 keeps a_f = 1--//
+    mat Xt = X.t();
+    vec step = zeros<vec>(F);
+
+    for(uword i=0; i<Xt.n_cols; i++)
+    {
+        for(uint32_t f=0; f<F; f++)
+        {
+            double v = fabs(frozenFeature(m, Xt.colptr(i), f));
+            step(f) = (v > step(f)) ? v : step(f);
+        }
+    }
+
+    for(uint32_t f=0; f<F; f++)
+    {
+        step(f) = (step(f) > 0.0) ? (step(f) / INT8_LEVELS) : 1.0;
+    }
+
+    uint64_t mu_at = 0;
+    uint64_t inv_step_at = mu_at + modelFileAligned(F * sizeof(double));
+    uint64_t offset_at = inv_step_at + modelFileAligned(F * sizeof(double));
+    uint64_t attribute_at = offset_at + modelFileAligned((F + 1) * sizeof(uint32_t));
+    uint64_t power_at = attribute_at + modelFileAligned(T * sizeof(uint32_t));
+    uint64_t weights_at = power_at + modelFileAligned(T * sizeof(uint32_t));
+    uint64_t bias_at = weights_at + modelFileAligned((uint64_t) K * d_width);
+    uint64_t scale_at = bias_at + modelFileAligned(K * sizeof(double));
+    uint64_t bytes = scale_at + modelFileAligned(K * sizeof(double));
+
+    if(posix_memalign(&d_block, MODEL_FILE_ALIGNMENT, bytes))
+    {
+        cerr << "Regression: QuantizedPredictor class." << endl
+             << "QuantizedPredictor(const Predictor&, const mat&) constructor." << endl
+             << "Cannot allocate the quantized model."
+             << endl;
+
+        exit(1);
+    }
+
+    char* base = (char*) d_block;
+    memset(base, 0, bytes);
+
+    double* mu_s = (double*) (base + mu_at);
+    double* inv_step_s = (double*) (base + inv_step_at);
+    uint32_t* offset_s = (uint32_t*) (base + offset_at);
+    uint32_t* attribute_s = (uint32_t*) (base + attribute_at);
+    uint32_t* power_s = (uint32_t*) (base + power_at);
+    int8_t* weights_s = (int8_t*) (base + weights_at);
+    double* bias_s = (double*) (base + bias_at);
+    double* scale_s = (double*) (base + scale_at);
+
+    for(uint32_t f=0; f<F; f++)
+    {
+        mu_s[f] = m.mu[f];
+        inv_step_s[f] = m.inv_sigma[f] / step(f);
+    }
+
+    memcpy(offset_s, m.plan_offset, (F + 1) * sizeof(uint32_t));
+    memcpy(attribute_s, m.plan_attribute, T * sizeof(uint32_t));
+    memcpy(power_s, m.plan_power, T * sizeof(uint32_t));
+
+    //--s_k = max_f |Ө_fk a_f| / 127; the bias stays in double, as it is added once per class--//
+    for(uint32_t k=0; k<K; k++)
+    {
+        double range = 0;
+
+        for(uint32_t f=0; f<F; f++)
+        {
+            double w = fabs(m.theta[((uint64_t) (f + 1) * K) + k] * step(f));
+            range = (w > range) ? w : range;
+        }
+
+        scale_s[k] = (range > 0.0) ? (range / INT8_LEVELS) : 1.0;
+        bias_s[k] = m.theta[k];
+
+        for(uint32_t f=0; f<F; f++)
+        {
+            weights_s[((uint64_t) k * d_width) + f] = toInt8((m.theta[((uint64_t) (f + 1) * K) + k] * step(f)) / scale_s[k]);
+        }
+    }
+
+    d_plan = m;
+    d_plan.mu = mu_s;
+    d_plan.inv_sigma = inv_step_s;
+    d_plan.theta = NULL;
+    d_plan.plan_offset = offset_s;
+    d_plan.plan_attribute = attribute_s;
+    d_plan.plan_power = power_s;
+    d_plan.label = NULL;
+
+    d_weights = weights_s;
+    d_bias = bias_s;
+    d_scale = scale_s;
+}
+
+
+// DESTRUCTOR
+
+/// Releases the quantized model.
+
+QuantizedPredictor::~QuantizedPredictor()
+{
+    free(d_block);
+}
+
+
+// unsigned int N(void) const method
+
+/// Returns the number of raw attributes of an instance.
+
+unsigned int QuantizedPredictor::N(void) const
+{
+    return d_plan.attributes;
+}
+
+
+// unsigned int K(void) const method
+
+/// Returns the number of classes.
+
+unsigned int QuantizedPredictor::K(void) const
+{
+    return d_plan.classes;
+}
+
+
+// unsigned int width(void) const method
+
+/// Returns the number of int8 features of a quantized instance, padding included.
+
+unsigned int QuantizedPredictor::width(void) const
+{
+    return d_width;
+}
+
+
+// void quantize(const double*, int8_t*) const method
+
+/// Maps, normalizes and quantizes a raw instance to int8, saturating at ±127.
+/// @param x Raw instance of N() attributes.
+/// @param xq Buffer of width() int8 to hold the quantized instance, padding zeroed.
+
+void QuantizedPredictor::quantize(const double* x, int8_t* xq) const
+{
+    for(uint32_t f=0; f<d_plan.features; f++)
+    {
+        xq[f] = toInt8(frozenFeature(d_plan, x, f));
+    }
+
+    for(uint32_t f=d_plan.features; f<d_width; f++)
+    {
+        xq[f] = 0;
+    }
+}
+
+
+// uword classify(const double*, int8_t*) const method
+
+/// Returns the predicted class of a raw instance from its int8 logits. Does not allocate.
+/// @param x Raw instance of N() attributes.
+/// @param xq Buffer of width() int8, left holding the quantized instance.
+
+uword QuantizedPredictor::classify(const double* x, int8_t* xq) const
+{
+    quantize(x, xq);
+
+    uword best = 0;
+    double z_best = 0;
+
+    for(uint32_t k=0; k<d_plan.classes; k++)
+    {
+        double z = d_bias[k] + (d_scale[k] * SimdMath::dot8(d_weights + ((uint64_t) k * d_width), xq, d_width));
+
+        if(k == 0 || z > z_best)
+        {
+            best = k;
+            z_best = z;
+        }
+    }
+
+    return best;
+}
+
+
+// void evaluate(const Predictor&, const mat&, const uvec&, const unsigned int) const method
+
+/// Prints the accuracy and throughput of this int8 model against the double model it was quantized from,
+/// over held-out instances, with the share of instances on which the two agree.
+/// @param reference The frozen double model this one was quantized from.
+/// @param X Raw held-out instances, one per row.
+/// @param actual True class index of each instance.
+/// @param repeats Number of timed passes over the instances > 0.
+
+void QuantizedPredictor::evaluate(const Predictor& reference, const mat& X, const uvec& actual, const unsigned int repeats) const
+{
+    if(X.n_cols != d_plan.attributes || !X.n_rows || actual.n_elem != X.n_rows || !repeats)
+    {
+        cerr << "Regression: QuantizedPredictor class." << endl
+             << "void evaluate(const Predictor&, const mat&, const uvec&, const unsigned int) const method." << endl
+             << "Matrix X: " << X.n_rows << "x" << X.n_cols << " must be non-empty with " << d_plan.attributes
+             << " colums and one row per class index: " << actual.n_elem << ", and repeats: " << repeats << " must be > 0."
+             << endl;
+
+        exit(1);
+    }
+
+    mat Xt = X.t();
+    uword m = Xt.n_cols;
+
+    vector<double> z(d_plan.classes);
+    vector<int8_t> xq(d_width);
+
+    uvec predicted_double(m);
+    uvec predicted_int8(m);
+
+    for(uword i=0; i<m; i++)
+    {
+        predicted_double(i) = reference.classify(Xt.colptr(i), &z[0]);
+        predicted_int8(i) = classify(Xt.colptr(i), &xq[0]);
+    }
+
+    double accuracy_double = ((double) accu(predicted_double == actual)) / m;
+    double accuracy_int8 = ((double) accu(predicted_int8 == actual)) / m;
+    double agreement = ((double) accu(predicted_double == predicted_int8)) / m;
+
+    //--Summing the predictions into a volatile keeps the timed loops from being optimized away--//
+    volatile uword sink = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(unsigned int r=0; r<repeats; r++)
+    {
+        for(uword i=0; i<m; i++)
+        {
+            sink = sink + reference.classify(Xt.colptr(i), &z[0]);
+        }
+    }
+    double rate_double = ((double) m * repeats) / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for(unsigned int r=0; r<repeats; r++)
+    {
+        for(uword i=0; i<m; i++)
+        {
+            sink = sink + classify(Xt.colptr(i), &xq[0]);
+        }
+    }
+    double rate_int8 = ((double) m * repeats) / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << endl << "Int8 quantized classifier (" << m << " held-out instances, " << d_plan.features << " features, "
+         << d_plan.classes << " classes, dot product: " << SimdMath::isaName(SimdMath::isa()) << ")"
+         << endl << "#Model  #Accuracy  #Instances/s  #Weight_bytes" << endl
+         << "double  " << accuracy_double << "  " << rate_double << "  " << ((d_plan.features + 1) * d_plan.classes * sizeof(double)) << endl
+         << "int8  " << accuracy_int8 << "  " << rate_int8 << "  " << ((d_plan.classes * d_width) + (2 * d_plan.classes * sizeof(double))) << endl
+         << endl << "Accuracy delta(int8 - double): " << (accuracy_int8 - accuracy_double)
+         << endl << "Agreement: " << agreement
+         << endl << "Speedup: " << (rate_int8 / rate_double) << endl;
+}
@@ -0,0 +1,66 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   Q U A N T I Z E D   P R E D I C T O R   C L A S S   H E A D E R                        */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef QUANTIZED_PREDICTOR_H
+#define QUANTIZED_PREDICTOR_H
+
+#include<iostream>
+#include<stdint.h>
+
+#include "armadillo"
+#include "predictor.h"
+#include "model_file.h"
+
+using namespace std;
+using namespace arma;
+
+#define INT8_LEVELS 127             //--Symmetric int8 range [-127, 127]; -128 is never produced--//
+#define INT8_WIDTH_MULTIPLE 64      //--Features are zero-padded to a whole number of cache lines--//
+
+//--Post-training int8 quantization of a frozen classifier, for scoring that only needs the arg max.  --//
+//--Feature f is normalized and quantized in steps a_f, calibrated so that the largest |x̂_f| seen maps--//
+//--to 127; a_f is folded into Ө, which is then quantized per class in steps s_k. The logits are     --//
+//--z_k = Ө_0k + s_k ∑ q_fk x_f, the sum taken over int8 with exact int32 accumulation.              --//
+class QuantizedPredictor
+{
+public:
+    QuantizedPredictor(const Predictor&, const mat&);
+    ~QuantizedPredictor();
+
+    QuantizedPredictor(const QuantizedPredictor&) = delete;
+    QuantizedPredictor& operator=(const QuantizedPredictor&) = delete;
+
+    unsigned int N(void) const;
+    unsigned int K(void) const;
+    unsigned int width(void) const;
+
+    void quantize(const double*, int8_t*) const;
+    uword classify(const double*, int8_t*) const;
+
+    void evaluate(const Predictor&, const mat&, const uvec&, const unsigned int) const;
+
+private:
+    void* d_block;
+
+    FrozenModel d_plan;             //--Exponent plan, μ and 1/(σ_f a_f): features come out in int8 steps--//
+    unsigned int d_width;           //--Features padded to INT8_WIDTH_MULTIPLE--//
+
+    //--Sections of d_block--//
+    const int8_t* d_weights;        //--q_fk, class-major: the d_width weights of a class are contiguous--//
+    const double* d_bias;           //--Ө_0k--//
+    const double* d_scale;          //--s_k--//
+};
+
+#endif // QUANTIZED_PREDICTOR_H
@@ -15,6 +15,23 @@
 
 #include "regression.h"
 
+#include<unistd.h>
+
+
+static unsigned long l2CacheBytes(void)
+{
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+
+    if(bytes > 0)
+    {
+        return bytes;
+    }
+#endif
+
+    return L2_CACHE_BYTES;
+}
+
 
 Regression::Regression(const DataSet& ds, const char* type):d_dset(ds)
 {
@@ -58,83 +75,826 @@ Regression::Regression(const DataSet& ds, const char* type):d_dset(ds)
         exit(1);
     }
 
-    //--Initialize theta matrix with uniform random--//
-    d_Theta.randu();
+    //--Initialize theta matrix with uniform random, from the model's own random engine--//
+    d_rng.seed(rand());
+    init_theta();
 
     //--Default 𝛼 and λ parameter values--//
     d_alpha = 0.1;
     d_lamda = 0.0;
 
-    //--Initialize λ-graph file--//
-    remove("../Output/lamda_cost.dat");
-    d_lamdaCostGraph.open("../Output/lamda_cost.dat", ios_base::out);
-    d_lamdaCostGraph << "#Lamda  #Cost" << endl;
+    //--Default early stopping parameters: validate every 10 iterations, stop after 5 without improvement--//
+    d_val_interval = 10;
+    d_patience = 5;
+
+    //--Default telemetry: text cost and λ graphs; files are only created once training starts--//
+    d_telemetry_sink = Telemetry::Text;
+    d_cost_path = "../Output/cost.dat";
+    d_lamda_path = "../Output/lamda_cost.dat";
+
+    //--Checkpointing is disabled by default--//
+    d_checkpoint_interval = 0;
 }
 
 
 Regression::~Regression()
 {
+    d_checkpointer.stop();
+    d_costGraph.close();
     d_lamdaCostGraph.close();
 }
 
 
 double Regression::gradientdescent(mat X, const mat Y, const double delta, const unsigned int max_iter = 0)
 {
-    unsigned int m = X.n_rows;
+    DataView train_view(X, Y, trainingLabels());
+
+    return train(train_view, NULL, delta, max_iter, NULL);
+}
+
+
+double Regression::gradientdescent(const QuantizedMatrix& X, const mat& Y, const double delta, const unsigned int max_iter = 0)
+{
+    //--The 8-bit matrix is never expanded: step() dequantizes one tile at a time into the workspace--//
+    DataView train_view(X, Y, trainingLabels());
+
+    return train(train_view, NULL, delta, max_iter, NULL);
+}
+
+
+double Regression::gradientdescent(const mat& X, const mat& Y, const uvec& rows, const double delta, const unsigned int max_iter = 0)
+{
+    //--Trains on the rows of X and Y listed in rows, gathered one tile at a time; X is never copied--//
+    DataView train_view(X, Y, trainingLabels(), rows);
+
+    return train(train_view, NULL, delta, max_iter, NULL);
+}
+
+
+double Regression::gradientdescent(mat X, const mat Y, const mat& X_val, const mat& Y_val, const double delta, const unsigned int max_iter = 0)
+{
+    if(X_val.n_cols != X.n_cols || !X_val.n_rows)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "double gradientdescent(mat, const mat, const mat&, const mat&, const double, const unsigned int) method" << endl
+             << "Validation matrix X_val: " << X_val.n_rows << "x" << X_val.n_cols
+             << " must be non-empty with as many colums as X: " << X.n_cols << endl;
+
+        exit(1);
+    }
 
-    //--Adding bias terms to the data--//
-    vec X_0 = ones<vec>(m);
-    X.insert_cols(0, X_0);
+    DataView train_view(X, Y, trainingLabels());
+    DataView validation(X_val, Y_val, trainingLabels());
+
+    return train(train_view, &validation, delta, max_iter, NULL);
+}
+
+
+double Regression::resume(mat X, const mat Y, const string& path, const double delta, const unsigned int max_iter = 0)
+{
+    DataView train_view(X, Y, trainingLabels());
+
+    return resume(train_view, path, delta, max_iter);
+}
+
+
+double Regression::resume(const mat& X, const mat& Y, const uvec& rows, const string& path, const double delta, const unsigned int max_iter = 0)
+{
+    DataView train_view(X, Y, trainingLabels(), rows);
+
+    return resume(train_view, path, delta, max_iter);
+}
+
+
+double Regression::resume(const QuantizedMatrix& X, const mat& Y, const string& path, const double delta, const unsigned int max_iter = 0)
+{
+    DataView train_view(X, Y, trainingLabels());
+
+    return resume(train_view, path, delta, max_iter);
+}
+
+
+double Regression::resume(const DataView& train_view, const string& path, const double delta, const unsigned int max_iter)
+{
+    Checkpoint checkpoint;
+
+    if(!Checkpointer::load(path, checkpoint))
+    {
+        cerr << "Regression: Regression class." << endl
+             << "double resume(const DataView&, const string&, const double, const unsigned int) method" << endl
+             << "Cannot load a valid checkpoint from file: " << path << endl;
+
+        exit(1);
+    }
+
+    if(checkpoint.theta.n_rows != d_Theta.n_rows || checkpoint.theta.n_cols != d_Theta.n_cols)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "double resume(const DataView&, const string&, const double, const unsigned int) method" << endl
+             << "Checkpoint Theta: " << checkpoint.theta.n_rows << "x" << checkpoint.theta.n_cols
+             << " does not match model Theta: " << d_Theta.n_rows << "x" << d_Theta.n_cols << endl;
+
+        exit(1);
+    }
+
+    unsigned long long fingerprint = Checkpointer::fingerprint(train_view);
+
+    if(checkpoint.fingerprint != fingerprint)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "double resume(const DataView&, const string&, const double, const unsigned int) method" << endl
+             << "Checkpoint file: " << path << " was taken on a different training set." << endl;
+
+        exit(1);
+    }
+
+    d_Theta = checkpoint.theta;
+    d_alpha = checkpoint.alpha;
+    d_lamda = checkpoint.lamda;
+
+    istringstream rng_state(checkpoint.rng_state);
+    rng_state >> d_rng;
+
+    cout << endl << "Resuming from checkpoint: " << path << " at iteration " << checkpoint.iteration << endl;
+
+    return train(train_view, NULL, delta, max_iter, &checkpoint);
+}
+
+
+double Regression::train(const DataView& train_view, const DataView* validation, const double delta, const unsigned int max_iter, const Checkpoint* resumed)
+{
+    if(train_view.N() != d_Theta.n_rows-1)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "double train(const DataView&, const DataView*, const double, const unsigned int, const Checkpoint*) method" << endl
+             << "Colum size of matrix X: "<< train_view.N()
+             << " and row size of Theta: " << d_Theta.n_rows << " are incompatable." << endl;
+
+        exit(1);
+    }
 
     double c = 0;
-    double c_prev=0;
-    unsigned int it=0;
+    double c_prev = 0;
+    unsigned int it = 0;
 
-    //--Calculating pretrained cost of the dataset--//
-    c = cost(X, Y);
+    //--Checkpoints carry a fingerprint of the data as given, without the bias column--//
+    if(d_checkpoint_interval)
+    {
+        d_checkpoint.fingerprint = Checkpointer::fingerprint(train_view);
+        d_checkpointer.start(d_checkpoint_path);
+    }
+
+    //--A resumed run continues after the checkpointed iteration, with its cost history--//
+    if(resumed)
+    {
+        it = resumed->iteration + 1;
+        c_prev = resumed->prev_cost;
+    }
 
-    fstream costGraph;
-    remove("../Output/cost.dat");
-    costGraph.open("../Output/cost.dat", ios_base::out);
-    costGraph << "#Iteration  #Cost" << endl;
-    costGraph << it++ << " " << c << endl;
+    d_costGraph.open(d_telemetry_sink, d_cost_path, "#Iteration  #Cost", resumed != NULL);
 
     cout << endl << "Training..." << endl;
 
+    c = descend(train_view, delta, max_iter, it, c_prev, &d_costGraph, validation);
+
+    d_checkpointer.stop();
+
+    cout << endl << "Finished training. Training details:"
+         << endl << "Iterations: " << it
+         << endl << "Delta_J(Theta): " << fabs(c_prev - c)
+         << endl << "J(Theta): " << c << endl;
+
+    d_costGraph.close();
+
+    recordLamdaCost(c);
+
+    return c;
+}
+
+
+double Regression::descend(const DataView& train_view, const double delta, const unsigned int max_iter, unsigned int& it, double& c_prev, Telemetry* costGraph, const DataView* validation)
+{
+    //--The bias column is added tile by tile; Ө is taken as is, so successive calls warm-start--//
+    //--it > 0 resumes a run: it is the next iteration and c_prev the cost before the current one--//
+    unsigned int m = train_view.M();
+
+    double c = 0;
+
+    //--Every temporary of the loop lives in the workspaces, sized here once--//
+    reserveWorkspace(train_view, d_Theta, d_workspace);
+
+    if(validation)
+    {
+        reserveWorkspace(*validation, d_Theta, d_validation_workspace);
+    }
+
+    //--Early stopping state, used only when a validation view is given--//
+    double best_val = datum::inf;
+    unsigned int best_it = 0;
+    unsigned int stale = 0;
+    bool stop = false;
+
+    //--Calculating pretrained cost of the dataset, together with the gradient for the first step--//
+    c = step(train_view);
+
+    if(!it)
+    {
+        c_prev = c;
+
+        if(costGraph)
+        {
+            costGraph->record(it, c);
+        }
+        it++;
+    }
+    else if(!(fabs(c_prev - c) > delta && (max_iter ? ((it <= max_iter) ? true : false) : true)))
+    {
+        return c;
+    }
+
+    //--Per-iteration metrics are only measured when someone is listening--//
+    bool observed = !d_observers.empty();
+    chrono::steady_clock::time_point start;
+    IterationMetrics metrics;
+
+    //--GEMM work per iteration: XΘ and X'r in step()--//
+    double flops = 4.0 * m * d_Theta.n_rows * d_Theta.n_cols;
+
     do
     {
+        if(observed)
+        {
+            start = chrono::steady_clock::now();
+        }
+
         //--               𝛼   ∂J(Ө)  --//
         //-- Θ_j := Θ_j - --- ------- --//
         //--               m   ∂Θ_j   --//
 
-        d_Theta = d_Theta - ((d_alpha/m) * derivative(X,Y));
+        d_Theta -= (d_alpha/m) * d_workspace.grad;
+
+        if(observed)
+        {
+            metrics.gradient_norm = norm(d_workspace.grad, "fro") / m;
+        }
 
         c_prev = c;
-        c = cost(X, Y);
+        c = step(train_view);
 
-        costGraph << it++ << " " << c << endl;
+        if(costGraph)
+        {
+            costGraph->record(it, c);
+        }
 
-    }while(fabs(c_prev - c) > delta && (max_iter ? ((it <= max_iter) ? true : false) : true));
+        if(observed)
+        {
+            metrics.iteration = it;
+            metrics.wall_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            metrics.rows_per_sec = m / metrics.wall_time;
+            metrics.gflops = (flops / metrics.wall_time) * 1e-9;
+            metrics.step_size = d_alpha / m;
+            metrics.cost = c;
 
-    cout << endl << "Finished training. Training details:"
-         << endl << "Iterations: " << it
-         << endl << "Delta_J(Theta): " << fabs(c_prev - c)
-         << endl << "J(Theta): " << c << endl;
+            for(unsigned int o=0; o<d_observers.size(); o++)
+            {
+                d_observers[o]->onIteration(metrics);
+            }
+        }
+
+        if(d_checkpointer.isRunning() && !(it % d_checkpoint_interval))
+        {
+            //--Only the snapshot is taken here; the file is written by the checkpointer's thread--//
+            ostringstream rng_state;
+            rng_state << d_rng;
+
+            d_checkpoint.theta = d_Theta;
+            d_checkpoint.iteration = it;
+            d_checkpoint.cost = c;
+            d_checkpoint.prev_cost = c_prev;
+            d_checkpoint.alpha = d_alpha;
+            d_checkpoint.lamda = d_lamda;
+            d_checkpoint.rng_state = rng_state.str();
+
+            d_checkpointer.submit(d_checkpoint);
+        }
+
+        if(validation && !(it % d_val_interval))
+        {
+            //--Fused forward pass over the validation set: logits and loss per tile, no gradient--//
+            double val = sweep(*validation, d_Theta, NULL, d_validation_workspace) / validation->M();
+
+            if(val < best_val)
+            {
+                best_val = val;
+                best_it = it;
+                d_workspace.best_theta = d_Theta;
+                stale = 0;
+            }
+            else if(++stale >= d_patience)
+            {
+                stop = true;
+            }
+        }
+        it++;
+
+    }while(!stop && fabs(c_prev - c) > delta && (max_iter ? ((it <= max_iter) ? true : false) : true));
+
+    if(best_it && best_it != it-1)
+    {
+        cout << endl << "Early stopping at iteration " << it-1 << ": restoring Theta of iteration " << best_it
+             << " with validation J(Theta): " << best_val << endl;
+
+        d_Theta = d_workspace.best_theta;
+        c = step(train_view);
+    }
+
+    return c;
+}
+
+
+RegularizationPath Regression::regularizationPath(mat X, const mat Y, mat X_val, const mat Y_val, vec lamdas, const double delta, const unsigned int max_iter = 0)
+{
+    if(lamdas.is_empty())
+    {
+        cerr << "Regression: Regression class." << endl
+             << "RegularizationPath regularizationPath(mat, const mat, mat, const mat, vec, const double, const unsigned int) method" << endl
+             << "Lamda grid cannot be empty." << endl;
+
+        exit(1);
+    }
+
+    if(lamdas.min() < 0.0)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "RegularizationPath regularizationPath(mat, const mat, mat, const mat, vec, const double, const unsigned int) method" << endl
+             << "Lamda: "<< lamdas.min()  << " must be >= 0." << endl;
+
+        exit(1);
+    }
+
+    if(X.n_cols != d_Theta.n_rows-1 || X_val.n_cols != d_Theta.n_rows-1)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "RegularizationPath regularizationPath(mat, const mat, mat, const mat, vec, const double, const unsigned int) method" << endl
+             << "Colum size of matrices X: "<< X.n_cols << " and X_val: " << X_val.n_cols
+             << " and row size of Theta: " << d_Theta.n_rows << " are incompatable." << endl;
+
+        exit(1);
+    }
+
+    //--Solve from the most to the least regularized problem, so each Ө is a good start for the next--//
+    RegularizationPath path;
+    path.lamda = sort(lamdas, "descend");
+    path.theta.set_size(d_Theta.n_rows, d_Theta.n_cols, path.lamda.n_rows);
+    path.train_cost.set_size(path.lamda.n_rows);
+    path.validation_cost.set_size(path.lamda.n_rows);
+
+    //--Training tiles get their bias column from the view; the validation set gets it once for the whole path--//
+    DataView train_view(X, Y, trainingLabels());
+    X_val.insert_cols(0, ones<vec>(X_val.n_rows));
+
+    unsigned int it = 0;
+    unsigned int total_it = 0;
+    double c_prev = 0;
+
+    cout << endl << "Regularization path over " << path.lamda.n_rows << " lamda values..." << endl
+         << "#Lamda  #Iterations  #J_train(Theta)  #J_val(Theta)" << endl;
+
+    for(unsigned int s=0; s<path.lamda.n_rows; s++)
+    {
+        d_lamda = path.lamda(s);
+        it = 0;
+        path.train_cost(s) = descend(train_view, delta, max_iter, it, c_prev, NULL, NULL);
+        total_it += it;
+
+        //--Validation cost is measured without the λ penalty so that points along the path are comparable--//
+        d_lamda = 0.0;
+        path.validation_cost(s) = cost(X_val, Y_val);
+        d_lamda = path.lamda(s);
+
+        path.theta.slice(s) = d_Theta;
+
+        recordLamdaCost(path.train_cost(s));
+
+        cout << d_lamda << "  " << it << "  " << path.train_cost(s) << "  " << path.validation_cost(s) << endl;
+    }
+
+    //--Leave the model at the point of the path with the lowest validation cost--//
+    uword best = path.validation_cost.index_min();
+    d_Theta = path.theta.slice(best);
+    d_lamda = path.lamda(best);
+
+    cout << endl << "Finished regularization path. Path details:"
+         << endl << "Total iterations: " << total_it
+         << endl << "Best lamda: " << d_lamda
+         << endl << "J_val(Theta): " << path.validation_cost(best) << endl;
+
+    return path;
+}
+
+
+CrossValidation Regression::crossValidate(const mat& X, const mat& Y, const unsigned int folds, const bool stratified, const double delta, const unsigned int max_iter, const unsigned int threads) const
+{
+    DataView view(X, Y, trainingLabels());
+
+    return crossValidate(view, folds, stratified, delta, max_iter, threads);
+}
+
+
+CrossValidation Regression::crossValidate(const mat& X, const mat& Y, const uvec& rows, const unsigned int folds, const bool stratified, const double delta, const unsigned int max_iter, const unsigned int threads) const
+{
+    //--Folds are drawn from the rows listed in rows only, e.g. the training split, without copying X--//
+    DataView view(X, Y, trainingLabels(), rows);
+
+    return crossValidate(view, folds, stratified, delta, max_iter, threads);
+}
+
+
+CrossValidation Regression::crossValidate(const QuantizedMatrix& X, const mat& Y, const unsigned int folds, const bool stratified, const double delta, const unsigned int max_iter, const unsigned int threads) const
+{
+    DataView view(X, Y, trainingLabels());
+
+    return crossValidate(view, folds, stratified, delta, max_iter, threads);
+}
+
+
+CrossValidation Regression::crossValidate(const DataView& view, const unsigned int folds, const bool stratified, const double delta, const unsigned int max_iter, const unsigned int threads) const
+{
+    unsigned int m = view.M();
+
+    if(folds < 2 || folds > m)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "CrossValidation crossValidate(const DataView&, const unsigned int, const bool, const double, const unsigned int, const unsigned int) const method" << endl
+             << "Number of folds: " << folds << " must be in the range [2," << m << "]." << endl;
+
+        exit(1);
+    }
+
+    if(view.N() != d_Theta.n_rows-1)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "CrossValidation crossValidate(const DataView&, const unsigned int, const bool, const double, const unsigned int, const unsigned int) const method" << endl
+             << "Colum size of matrix X: "<< view.N()  << " and row size of Theta: " << d_Theta.n_rows << " are incompatable." << endl;
+
+        exit(1);
+    }
+
+    if(stratified && d_reg_type != Classif)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "CrossValidation crossValidate(const DataView&, const unsigned int, const bool, const double, const unsigned int, const unsigned int) const method" << endl
+             << "Stratified folds require a classification model." << endl;
+
+        exit(1);
+    }
+
+    //--Assign every instance to a fold; stratification deals each class round-robin over the folds--//
+    uvec order = randperm(m);
+
+    if(stratified)
+    {
+        uvec label(m);
+        for(unsigned int i=0; i<m; i++)
+        {
+            label(i) = trueClass(view.Y(), view.labels(), view.index(i));
+        }
+
+        uvec grouped = order.elem(stable_sort_index(label.elem(order)));
+        order = grouped;
+    }
+
+    uvec fold(m);
+    for(unsigned int j=0; j<m; j++)
+    {
+        fold(order(j)) = j % folds;
+    }
+
+    CrossValidation cv;
+    cv.train_cost.set_size(folds);
+    cv.validation_cost.set_size(folds);
+    cv.f1_score.set_size(folds);
+
+    //--Folds are sub-views over the shared X and Y; each task only owns its Ө and row indices--//
+    ThreadPool pool(threads);
+
+    for(unsigned int f=0; f<folds; f++)
+    {
+        pool.enqueue([this, &view, &fold, &cv, f, delta, max_iter]()
+        {
+            DataView train(view, find(fold != f));
+            DataView validation(view, find(fold == f));
+
+            mat theta = d_Theta;
+            unsigned int it = 0;
+
+            cv.train_cost(f) = fit(train, theta, delta, max_iter, it);
+            evaluate(validation, theta, cv.validation_cost(f), cv.f1_score(f));
+        });
+    }
+
+    pool.wait();
+
+    cv.mean_validation_cost = mean(cv.validation_cost);
+    cv.stddev_validation_cost = stddev(cv.validation_cost);
+    cv.mean_f1_score = mean(cv.f1_score);
+
+    cout << endl << "Finished " << folds << "-fold" << (stratified ? " stratified" : "") << " cross-validation. Fold details:"
+         << endl << "#Fold  #J_train(Theta)  #J_val(Theta)  #F1_Score" << endl;
+
+    for(unsigned int f=0; f<folds; f++)
+    {
+        cout << f << "  " << cv.train_cost(f) << "  " << cv.validation_cost(f) << "  " << cv.f1_score(f) << endl;
+    }
+
+    cout << "Mean J_val(Theta): " << cv.mean_validation_cost << " +/- " << cv.stddev_validation_cost
+         << endl << "Mean F1_Score: " << cv.mean_f1_score << endl;
 
-    costGraph.close();
+    return cv;
+}
+
+
+double Regression::sweep(const DataView& view, const mat& theta, mat* grad, Workspace& ws) const
+{
+    //--One pass over the view, reserved in ws, in its L2-sized row tiles. X is streamed from memory once: --//
+    //--each tile is loaded into the workspace, where it feeds both XΘ and its share of X'r before the next--//
+    unsigned int m = view.M();
 
-    d_lamdaCostGraph << d_lamda << " " << c << endl;
+    bool indexed = view.classIndexed();
+    double loss = 0;
+
+    if(grad)
+    {
+        grad->zeros(theta.n_rows, theta.n_cols);
+    }
+
+    for(uword first=0; first<m; first+=ws.tile_rows)
+    {
+        uword rows_in_tile = (first + ws.tile_rows < m) ? ws.tile_rows : (m - first);
+
+        //--Headers over the workspace memory, shaped to this tile without allocating--//
+        mat tile(ws.tile.memptr(), rows_in_tile, theta.n_rows, false, true);
+        mat Z(ws.Z.memptr(), rows_in_tile, theta.n_cols, false, true);
+        uvec rows(ws.rows.memptr() + first, rows_in_tile, false, true);
+
+        view.loadTile(first, first + rows_in_tile - 1, tile);
+
+        Z = tile * theta;
+        loss += d_kernels.residual(Z, view.Y(), &rows, indexed);
+
+        if(grad)
+        {
+            *grad += tile.t() * Z;
+        }
+    }
+
+    return loss;
+}
+
+
+double Regression::fit(const DataView& train, mat& theta, const double delta, const unsigned int max_iter, unsigned int& it) const
+{
+    //--Gradient descent on an explicit Ө over a view of the data; the model's own Ө is not touched--//
+    unsigned int m = train.M();
+
+    //--Folds are fitted concurrently on one model, so each fit owns its workspace, reused by every iteration--//
+    Workspace ws;
+    reserveWorkspace(train, theta, ws);
+
+    mat& grad = ws.grad;
+    double c = 0;
+    double c_prev = 0;
+    it = 0;
+
+    while(true)
+    {
+        //--Cost and gradient at the current Ө from a single sweep over the fold--//
+        double loss = sweep(train, theta, &grad, ws);
+        double penalty = d_kernels.penalty(grad, theta, d_lamda);
+        c = (loss + penalty) / m;
+
+        if((it && fabs(c_prev - c) <= delta) || (max_iter && it >= max_iter))
+        {
+            break;
+        }
+
+        //--               𝛼                          --//
+        //-- Θ_j := Θ_j - --- [X'(h_Ө(X) - y) + λӨ_j] --//
+        //--               m                          --//
+
+        theta -= (d_alpha/m) * grad;
+
+        c_prev = c;
+        it++;
+    }
 
     return c;
 }
 
 
+void Regression::evaluate(const DataView& validation, const mat& theta, double& cost, double& f1) const
+{
+    unsigned int m = validation.M();
+    unsigned int classes = theta.n_cols;
+
+    //--Tiled like sweep(), in a workspace of its own--//
+    Workspace ws;
+    reserveWorkspace(validation, theta, ws);
+
+    //--Folds are evaluated concurrently, so each counts its own confusion matrix on its own thread--//
+    ClassificationMetrics metrics(classes, 1);
+    uvec actual;
+    bool indexed = validation.classIndexed();
+    double loss = 0;
+
+    for(uword first=0; first<m; first+=ws.tile_rows)
+    {
+        uword rows_in_tile = (first + ws.tile_rows < m) ? ws.tile_rows : (m - first);
+
+        mat tile(ws.tile.memptr(), rows_in_tile, theta.n_rows, false, true);
+        mat Z(ws.Z.memptr(), rows_in_tile, theta.n_cols, false, true);
+        uvec rows(ws.rows.memptr() + first, rows_in_tile, false, true);
+
+        validation.loadTile(first, first + rows_in_tile - 1, tile);
+
+        Z = tile * theta;
+
+        if(d_reg_type == Classif)
+        {
+            //--The link functions are monotone, so the arg max of the logits is the predicted class--//
+            uvec predicted = index_max(Z, 1);
+
+            actual.set_size(rows.n_rows);
+            for(uword t=0; t<rows.n_rows; t++)
+            {
+                actual(t) = trueClass(validation.Y(), validation.labels(), rows(t));
+            }
+
+            metrics.accumulate(actual, predicted);
+        }
+
+        loss += d_kernels.residual(Z, validation.Y(), &rows, indexed);
+    }
+
+    cost = loss / m;
+
+    if(d_reg_type != Classif)
+    {
+        f1 = datum::nan;
+        return;
+    }
+
+    //--Macro F1: F1_k = 2TP_k / (2TP_k + FP_k + FN_k), averaged over the classes--//
+    f1 = metrics.macroF1();
+}
+
+
+double Regression::hogwild(const mat& X, const mat& Y, const unsigned int threads, const unsigned int epochs)
+{
+    if(X.n_cols != d_Theta.n_rows-1)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "double hogwild(const mat&, const mat&, const unsigned int, const unsigned int) method" << endl
+             << "Colum size of matrix X: "<< X.n_cols  << " and row size of Theta: " << d_Theta.n_rows << " are incompatable." << endl;
+
+        exit(1);
+    }
+
+    //--Row-compressed view of X: column i of X' holds only the non-zero features of x⁽i⁾--//
+    sp_mat Xt(X.t());
+    Xt.sync();
+
+    return hogwild(Xt, Y, threads, epochs);
+}
+
+
+double Regression::hogwild(const sp_mat& Xt, const mat& Y, const unsigned int threads, const unsigned int epochs)
+{
+    //--Xt is built once by the caller, so that repeated calls time the SGD workers only--//
+    if(Xt.n_rows != d_Theta.n_rows-1)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "double hogwild(const sp_mat&, const mat&, const unsigned int, const unsigned int) method" << endl
+             << "Row size of matrix X': "<< Xt.n_rows  << " and row size of Theta: " << d_Theta.n_rows << " are incompatable." << endl;
+
+        exit(1);
+    }
+
+    if(!threads || !epochs)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "double hogwild(const sp_mat&, const mat&, const unsigned int, const unsigned int) method" << endl
+             << "Threads: " << threads << " and epochs: " << epochs << " must both be > 0." << endl;
+
+        exit(1);
+    }
+
+    unsigned int m = Xt.n_cols;
+    unsigned int updates = ((unsigned long) epochs * m) / threads;
+    bool indexed = (trainingLabels() == DataView::ClassIndices);
+
+    vector<thread> workers;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for(unsigned int t=0; t<threads; t++)
+    {
+        workers.push_back(thread(d_kernels.sgd, cref(Xt), cref(Y), ref(d_Theta), d_alpha, d_lamda, indexed, updates, (unsigned int) d_rng()));
+    }
+
+    for(unsigned int t=0; t<threads; t++)
+    {
+        workers[t].join();
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    //--Updates applied per second--//
+    return (((double) updates * threads) / elapsed.count());
+}
+
+
+void Regression::reserveWorkspace(const DataView& view, const mat& theta, Workspace& ws) const
+{
+    unsigned int m = view.M();
+    unsigned int cols = theta.n_rows;
+    unsigned int classes = theta.n_cols;
+    unsigned long tile_rows = (l2CacheBytes() / 2) / (sizeof(double) * (cols + classes));
+
+    ws.tile_rows = (tile_rows < 16) ? 16 : ((tile_rows > m) ? m : tile_rows);
+
+    //--set_size() keeps the memory when the shape is unchanged, so warm-started calls reuse it--//
+    ws.tile.set_size(ws.tile_rows, cols);
+    ws.Z.set_size(ws.tile_rows, classes);
+    ws.grad.set_size(cols, classes);
+    ws.best_theta.set_size(cols, classes);
+
+    if(m)
+    {
+        view.rowIndices(0, m-1, ws.rows);
+    }
+    else
+    {
+        ws.rows.reset();
+    }
+}
+
+
+double Regression::step(const DataView& train_view)
+{
+    //--Returns J(Ө) and leaves ∂J(Ө)/∂Ө in grad, from one tiled sweep over the training workspace--//
+    double loss = sweep(train_view, d_Theta, &d_workspace.grad, d_workspace);
+
+    //--Regularization skips the bias row--//
+    double penalty = d_kernels.penalty(d_workspace.grad, d_Theta, d_lamda);
+
+    return (loss + penalty) / train_view.M();
+}
+
+
+void Regression::recordLamdaCost(const double c)
+{
+    //--The λ graph spans all the training runs of the model, so it is opened on first use only--//
+    if(!d_lamdaCostGraph.isOpen())
+    {
+        d_lamdaCostGraph.open(d_telemetry_sink, d_lamda_path, "#Lamda  #Cost", false);
+    }
+
+    d_lamdaCostGraph.record(d_lamda, c);
+}
+
+
+double Regression::residual(mat& Z, const mat& Y, const uvec& rows) const
+{
+    //--Z holds XΘ for the instances in rows; replaced in place by ∂loss/∂z, returning the unregularized loss--//
+    return d_kernels.residual(Z, Y, &rows, trainingLabels() == DataView::ClassIndices);
+}
+
+
+DataView::Labels Regression::trainingLabels(void) const
+{
+    //--The training entry points take classification labels as Mx1 class indices, and targets otherwise--//
+    return (d_reg_type == Classif) ? DataView::ClassIndices : DataView::Targets;
+}
+
+
+uword Regression::trueClass(const mat& Y, const DataView::Labels labels, const uword i) const
+{
+    return (labels == DataView::ClassIndices) ? (uword) Y(i) : Y.col(i).index_max();
+}
+
+
 mat Regression::theta(void) const
 {
     return d_Theta;
 }
 
 
+const ModelKernels& Regression::kernels(void) const
+{
+    return d_kernels;
+}
+
+
 void Regression::init_theta(void)
 {
     if(d_Theta.n_rows == 0)
@@ -147,7 +907,8 @@ void Regression::init_theta(void)
     }
     else
     {
-        d_Theta.randu();
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        d_Theta.imbue([&]() { return uniform(d_rng); });
     }
 }
 
@@ -255,3 +1016,155 @@ void Regression::set_lamda(const double lamda)
         d_lamda = lamda;
     }
 }
+
+
+unsigned int Regression::validationInterval(void) const
+{
+    return d_val_interval;
+}
+
+
+void Regression::set_validationInterval(const unsigned int val_interval)
+{
+    if(!val_interval)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "void set_validationInterval(const unsigned int) method" << endl
+             << "Validation interval: "<< val_interval  << " must be > 0." << endl;
+
+        exit(1);
+    }
+    else
+    {
+        d_val_interval = val_interval;
+    }
+}
+
+
+unsigned int Regression::patience(void) const
+{
+    return d_patience;
+}
+
+
+void Regression::set_patience(const unsigned int patience)
+{
+    if(!patience)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "void set_patience(const unsigned int) method" << endl
+             << "Patience: "<< patience  << " must be > 0." << endl;
+
+        exit(1);
+    }
+    else
+    {
+        d_patience = patience;
+    }
+}
+
+
+void Regression::set_checkpoint(const string& path, const unsigned int interval)
+{
+    if(interval && path.empty())
+    {
+        cerr << "Regression: Regression class." << endl
+             << "void set_checkpoint(const string&, const unsigned int) method" << endl
+             << "Checkpoint path cannot be empty." << endl;
+
+        exit(1);
+    }
+
+    //--An interval of 0 disables checkpointing--//
+    d_checkpoint_path = path;
+    d_checkpoint_interval = interval;
+}
+
+
+void Regression::add_observer(TrainingObserver* observer)
+{
+    if(!observer)
+    {
+        cerr << "Regression: Regression class." << endl
+             << "void add_observer(TrainingObserver*) method" << endl
+             << "Observer cannot be NULL." << endl;
+
+        exit(1);
+    }
+
+    d_observers.push_back(observer);
+}
+
+
+void Regression::clear_observers(void)
+{
+    d_observers.clear();
+}
+
+
+string Regression::telemetrySink(void) const
+{
+    switch(d_telemetry_sink)
+    {
+    case Telemetry::None:
+    {
+        return("None");
+    }
+    case Telemetry::Text:
+    {
+        return("Text");
+    }
+    case Telemetry::Binary:
+    {
+        return("Binary");
+    }
+    default:
+    {
+        cerr << "Regression: Regression class." << endl
+             << "string telemetrySink(void) method" << endl
+             << "Invalid telemetry sink: "<< d_telemetry_sink  << endl;
+
+        exit(1);
+    }
+    }
+}
+
+
+void Regression::set_telemetry(const string& sink, const string& cost_path, const string& lamda_path)
+{
+    if(sink == "None")
+    {
+        d_telemetry_sink = Telemetry::None;
+    }
+    else if(sink == "Text")
+    {
+        d_telemetry_sink = Telemetry::Text;
+    }
+    else if(sink == "Binary")
+    {
+        d_telemetry_sink = Telemetry::Binary;
+    }
+    else
+    {
+        cerr << "Regression: Regression class." << endl
+             << "void set_telemetry(const string&, const string&, const string&) method" << endl
+             << "Invalid telemetry sink: "<< sink  << endl;
+
+        exit(1);
+    }
+
+    if(d_telemetry_sink != Telemetry::None && (cost_path.empty() || lamda_path.empty()))
+    {
+        cerr << "Regression: Regression class." << endl
+             << "void set_telemetry(const string&, const string&, const string&) method" << endl
+             << "Cost graph path: \"" << cost_path << "\" and lamda graph path: \"" << lamda_path << "\" cannot be empty." << endl;
+
+        exit(1);
+    }
+
+    d_cost_path = cost_path;
+    d_lamda_path = lamda_path;
+
+    //--A running λ graph is restarted on its next record with the new sink and path--//
+    d_lamdaCostGraph.close();
+}
@@ -18,25 +18,85 @@
 
 #include<iostream>
 #include<fstream>
+#include<sstream>
 #include<math.h>
+#include<thread>
+#include<vector>
+#include<random>
+#include<chrono>
 
 #include "armadillo"
 #include "dataset.h"
+#include "data_view.h"
+#include "thread_pool.h"
+#include "telemetry.h"
+#include "training_observer.h"
+#include "checkpoint.h"
+#include "model_kernel.h"
+#include "classification_metrics.h"
 
 using namespace std;
 using namespace arma;
 
+struct RegularizationPath
+{
+    vec lamda;              //--λ grid, in decreasing order--//
+    cube theta;             //--Slice s holds Ө fitted with lamda(s)--//
+    vec train_cost;         //--J(Ө) on the training set, including the λ penalty--//
+    vec validation_cost;    //--Unregularized J(Ө) on the validation set--//
+};
+
+struct CrossValidation
+{
+    vec train_cost;             //--J(Ө) of each fold on its training instances, including the λ penalty--//
+    vec validation_cost;        //--Unregularized J(Ө) of each fold on its held-out instances--//
+    vec f1_score;               //--Macro F1 score of each fold on its held-out instances (classification only)--//
+
+    double mean_validation_cost;
+    double stddev_validation_cost;
+    double mean_f1_score;
+};
+
+#define L2_CACHE_BYTES 262144      //--Assumed L2 size when the OS does not report one--//
+
+struct Workspace
+{
+    unsigned int tile_rows; //--Rows per tile, so that a tile of X and its logits fit in half of L2--//
+    mat tile;               //--Row tile of X with its bias column, loaded once per pass into cache--//
+    mat Z;                  //--Logits of the tile, replaced in place by the residual--//
+    mat grad;               //--Gradient, same shape as Ө--//
+    mat best_theta;         //--Ө with the best validation cost, for early stopping--//
+    uvec rows;              //--Rows of Y holding the instances of the view, for residual()--//
+};
+
 class Regression
 {
 public:
     enum RegressionType{Regres, Classif};
 
     Regression(const DataSet&, const char*);
-    ~Regression();
+    virtual ~Regression();
 
     double gradientdescent(mat, const mat, const double, const unsigned int);
+    double gradientdescent(const QuantizedMatrix&, const mat&, const double, const unsigned int);
+    double gradientdescent(const mat&, const mat&, const uvec&, const double, const unsigned int);
+    double gradientdescent(mat, const mat, const mat&, const mat&, const double, const unsigned int);
+    double resume(mat, const mat, const string&, const double, const unsigned int);
+    double resume(const mat&, const mat&, const uvec&, const string&, const double, const unsigned int);
+    double resume(const QuantizedMatrix&, const mat&, const string&, const double, const unsigned int);
+    double hogwild(const mat&, const mat&, const unsigned int, const unsigned int);
+    double hogwild(const sp_mat&, const mat&, const unsigned int, const unsigned int);
+    RegularizationPath regularizationPath(mat, const mat, mat, const mat, vec, const double, const unsigned int);
+    CrossValidation crossValidate(const mat&, const mat&, const unsigned int, const bool, const double, const unsigned int, const unsigned int) const;
+    CrossValidation crossValidate(const mat&, const mat&, const uvec&, const unsigned int, const bool, const double, const unsigned int, const unsigned int) const;
+    CrossValidation crossValidate(const QuantizedMatrix&, const mat&, const unsigned int, const bool, const double, const unsigned int, const unsigned int) const;
+
+    double sweep(const DataView&, const mat&, mat*, Workspace&) const;
+    double fit(const DataView&, mat&, const double, const unsigned int, unsigned int&) const;
+    void evaluate(const DataView&, const mat&, double&, double&) const;
 
     mat theta(void) const;
+    const ModelKernels& kernels(void) const;
     void init_theta(void);
     void printTheta(void) const;
 
@@ -49,11 +109,36 @@ public:
     double lamda(void) const;
     void set_lamda(const double);
 
+    unsigned int validationInterval(void) const;
+    void set_validationInterval(const unsigned int);
+
+    unsigned int patience(void) const;
+    void set_patience(const unsigned int);
+
+    void set_checkpoint(const string&, const unsigned int);
+
+    void add_observer(TrainingObserver*);
+    void clear_observers(void);
+
+    string telemetrySink(void) const;
+    void set_telemetry(const string&, const string&, const string&);
+
     virtual vec h_Theta(vec) const = 0;
     virtual double cost(mat&, const mat&) const = 0;
     virtual mat derivative(const mat&, const mat&) const = 0;
+    double residual(mat&, const mat&, const uvec&) const;
 
 protected:
+    double resume(const DataView&, const string&, const double, const unsigned int);
+    CrossValidation crossValidate(const DataView&, const unsigned int, const bool, const double, const unsigned int, const unsigned int) const;
+    double train(const DataView&, const DataView*, const double, const unsigned int, const Checkpoint*);
+    double descend(const DataView&, const double, const unsigned int, unsigned int&, double&, Telemetry*, const DataView*);
+    void recordLamdaCost(const double);
+    void reserveWorkspace(const DataView&, const mat&, Workspace&) const;
+    double step(const DataView&);
+    DataView::Labels trainingLabels(void) const;
+    uword trueClass(const mat&, const DataView::Labels, const uword) const;
+
     mat d_Theta;
 
     const DataSet& d_dset;
@@ -62,7 +147,29 @@ protected:
     double d_alpha;
     double d_lamda;
 
-    fstream d_lamdaCostGraph;
+    unsigned int d_val_interval;
+    unsigned int d_patience;
+
+    Telemetry::Sink d_telemetry_sink;
+    string d_cost_path;
+    string d_lamda_path;
+
+    Telemetry d_costGraph;
+    Telemetry d_lamdaCostGraph;
+
+    vector<TrainingObserver*> d_observers;
+
+    mt19937 d_rng;
+
+    string d_checkpoint_path;
+    unsigned int d_checkpoint_interval;
+    Checkpointer d_checkpointer;
+    Checkpoint d_checkpoint;
+
+    Workspace d_workspace;
+    Workspace d_validation_workspace;
+
+    ModelKernels d_kernels;
 };
 
 #endif // REGRESSION_H
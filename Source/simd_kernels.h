@@ -0,0 +1,180 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   S I M D   K E R N E L S   H E A D E R                                                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include<stddef.h>
+#include<stdint.h>
+#include<string.h>
+#include<limits>
+
+using namespace std;
+
+//--Array kernels of one instruction set, handed to SimdMath for runtime dispatch--//
+struct SimdKernels
+{
+    void (*exp)(double*, size_t);
+    void (*sigmoid)(double*, size_t);
+    void (*log)(double*, size_t);
+    int32_t (*dot8)(const int8_t*, const int8_t*, const size_t);
+};
+
+SimdKernels scalarKernels(void);
+
+#if defined(__x86_64__) || defined(__i386__)
+SimdKernels sse2Kernels(void);
+SimdKernels avx2Kernels(void);
+SimdKernels avx512Kernels(void);
+#endif
+
+//--The algorithms below are written once against a vector traits type T and instantiated in one--//
+//--translation unit per instruction set, each compiled with its own -m flags. They have internal--//
+//--linkage so an AVX instantiation can never be picked by the linker for another unit.          --//
+namespace
+{
+
+#define SIMD_MAGIC 6755399441055744.0       // 1.5 * 2^52: adding it rounds to the nearest integer
+#define SIMD_LOG2E 1.4426950408889634
+#define SIMD_LN2_HI 6.93147180369123816490e-01
+#define SIMD_LN2_LO 1.90821492927058770002e-10
+#define SIMD_SQRT2 1.4142135623730951
+#define SIMD_EXP_MIN -746.0
+#define SIMD_EXP_MAX 710.0
+
+//--e^x = 2^n e^r with n = round(x/ln2) and |r| <= ln2/2; e^r from its Taylor series to r^13.--//
+//--2^n is applied as 2^n1 2^n2 so overflow to inf and gradual underflow come out of the final--//
+//--multiply without special cases.                                                          --//
+template<class T> inline typename T::V expBlock(typename T::V x)
+{
+    typedef typename T::V V;
+    typedef typename T::M M;
+
+    M nan = T::isnan(x);
+    V c = T::min(T::max(x, T::set1(SIMD_EXP_MIN)), T::set1(SIMD_EXP_MAX));
+
+    V n = T::sub(T::fma(c, T::set1(SIMD_LOG2E), T::set1(SIMD_MAGIC)), T::set1(SIMD_MAGIC));
+    V r = T::fma(n, T::set1(-SIMD_LN2_HI), c);
+    r = T::fma(n, T::set1(-SIMD_LN2_LO), r);
+
+    V p = T::set1(1.0/6227020800.0);
+    p = T::fma(p, r, T::set1(1.0/479001600.0));
+    p = T::fma(p, r, T::set1(1.0/39916800.0));
+    p = T::fma(p, r, T::set1(1.0/3628800.0));
+    p = T::fma(p, r, T::set1(1.0/362880.0));
+    p = T::fma(p, r, T::set1(1.0/40320.0));
+    p = T::fma(p, r, T::set1(1.0/5040.0));
+    p = T::fma(p, r, T::set1(1.0/720.0));
+    p = T::fma(p, r, T::set1(1.0/120.0));
+    p = T::fma(p, r, T::set1(1.0/24.0));
+    p = T::fma(p, r, T::set1(1.0/6.0));
+    p = T::fma(p, r, T::set1(0.5));
+    p = T::fma(p, r, T::set1(1.0));
+    p = T::fma(p, r, T::set1(1.0));
+
+    V n1 = T::sub(T::fma(n, T::set1(0.5), T::set1(SIMD_MAGIC)), T::set1(SIMD_MAGIC));
+    V n2 = T::sub(n, n1);
+
+    V e = T::mul(T::mul(p, T::pow2(n1)), T::pow2(n2));
+
+    return T::select(nan, x, e);
+}
+
+//--x = 2^e m with m in [√½, √2); log(m) = 2 atanh(s), s = (m-1)/(m+1), |s| <= 0.172, to s^21.--//
+//--Subnormal inputs are rescaled by 2^54 first.                                              --//
+template<class T> inline typename T::V logBlock(typename T::V x)
+{
+    typedef typename T::V V;
+    typedef typename T::M M;
+
+    V zero = T::set1(0.0);
+    M sub = T::lt(x, T::set1(2.2250738585072014e-308));
+    V y = T::select(sub, T::mul(x, T::set1(18014398509481984.0)), x);
+
+    V e = T::sub(T::exponent(y), T::select(sub, T::set1(54.0), zero));
+    V m = T::mantissa(y);
+
+    M big = T::gt(m, T::set1(SIMD_SQRT2));
+    m = T::select(big, T::mul(m, T::set1(0.5)), m);
+    e = T::select(big, T::add(e, T::set1(1.0)), e);
+
+    V s = T::div(T::sub(m, T::set1(1.0)), T::add(m, T::set1(1.0)));
+    V s2 = T::mul(s, s);
+
+    V p = T::set1(1.0/21.0);
+    p = T::fma(p, s2, T::set1(1.0/19.0));
+    p = T::fma(p, s2, T::set1(1.0/17.0));
+    p = T::fma(p, s2, T::set1(1.0/15.0));
+    p = T::fma(p, s2, T::set1(1.0/13.0));
+    p = T::fma(p, s2, T::set1(1.0/11.0));
+    p = T::fma(p, s2, T::set1(1.0/9.0));
+    p = T::fma(p, s2, T::set1(1.0/7.0));
+    p = T::fma(p, s2, T::set1(1.0/5.0));
+    p = T::fma(p, s2, T::set1(1.0/3.0));
+    p = T::mul(T::mul(p, s2), T::add(s, s));
+
+    V l = T::fma(e, T::set1(SIMD_LN2_HI), T::add(T::add(s, s), T::fma(e, T::set1(SIMD_LN2_LO), p)));
+
+    //--log(±0) = -inf, log(x < 0) = NaN, log(inf) = inf, NaN stays NaN--//
+    V inf = T::set1(numeric_limits<double>::infinity());
+    l = T::select(T::eq(x, inf), inf, l);
+    l = T::select(T::eq(x, zero), T::sub(zero, inf), l);
+    l = T::select(T::lt(x, zero), T::set1(numeric_limits<double>::quiet_NaN()), l);
+
+    return T::select(T::isnan(x), x, l);
+}
+
+template<class T> inline typename T::V sigmoidBlock(typename T::V z)
+{
+    //--1 / (1 + e^(-z)); e^(-z) saturates to inf or 0, so the result saturates to 0 or 1--//
+    typename T::V one = T::set1(1.0);
+    return T::div(one, T::add(one, expBlock<T>(T::sub(T::set1(0.0), z))));
+}
+
+//--Full vectors are processed in place; the tail goes through one zero-padded vector--//
+template<class T, typename T::V (*Block)(typename T::V)> void applyInPlace(double* x, size_t n)
+{
+    size_t i = 0;
+
+    for(; i + T::width <= n; i += T::width)
+    {
+        T::store(x + i, Block(T::load(x + i)));
+    }
+
+    if(i < n)
+    {
+        double tail[T::width] = {0};
+        memcpy(tail, x + i, (n - i) * sizeof(double));
+
+        T::store(tail, Block(T::load(tail)));
+        memcpy(x + i, tail, (n - i) * sizeof(double));
+    }
+}
+
+template<class T> SimdKernels makeKernels(void)
+{
+    SimdKernels kernels;
+
+    kernels.exp = &applyInPlace< T, &expBlock<T> >;
+    kernels.sigmoid = &applyInPlace< T, &sigmoidBlock<T> >;
+    kernels.log = &applyInPlace< T, &logBlock<T> >;
+    kernels.dot8 = &T::dot8;
+
+    return kernels;
+}
+
+}
+
+#endif // SIMD_KERNELS_H
@@ -0,0 +1,367 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   S I M D   M A T H   C L A S S                                                          */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "simd_math.h"
+#include "simd_kernels.h"
+
+#include<math.h>
+#include<stdlib.h>
+#include<chrono>
+#include<vector>
+
+namespace
+{
+
+//--libm one element at a time; used when no vector unit is available--//
+void scalarExp(double* x, size_t n)
+{
+    for(size_t i=0; i<n; i++)
+    {
+        x[i] = ::exp(x[i]);
+    }
+}
+
+void scalarSigmoid(double* x, size_t n)
+{
+    for(size_t i=0; i<n; i++)
+    {
+        x[i] = 1.0 / (1.0 + ::exp(-x[i]));
+    }
+}
+
+void scalarLog(double* x, size_t n)
+{
+    for(size_t i=0; i<n; i++)
+    {
+        x[i] = ::log(x[i]);
+    }
+}
+
+int32_t scalarDot8(const int8_t* a, const int8_t* b, const size_t n)
+{
+    int32_t dot = 0;
+
+    for(size_t i=0; i<n; i++)
+    {
+        dot += a[i] * b[i];
+    }
+
+    return dot;
+}
+
+struct SimdDispatch
+{
+    SimdMath::ISA isa;
+    SimdKernels kernels;
+};
+
+SimdKernels kernelsOf(const SimdMath::ISA isa)
+{
+    switch(isa)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+    case SimdMath::AVX512:
+        return avx512Kernels();
+
+    case SimdMath::AVX2:
+        return avx2Kernels();
+
+    case SimdMath::SSE2:
+        return sse2Kernels();
+#endif
+    default:
+        return scalarKernels();
+    }
+}
+
+SimdMath::ISA bestISA(void)
+{
+    if(SimdMath::supported(SimdMath::AVX512))
+    {
+        return SimdMath::AVX512;
+    }
+    else if(SimdMath::supported(SimdMath::AVX2))
+    {
+        return SimdMath::AVX2;
+    }
+    else if(SimdMath::supported(SimdMath::SSE2))
+    {
+        return SimdMath::SSE2;
+    }
+
+    return SimdMath::Scalar;
+}
+
+//--Resolved once, on first use, from CPUID--//
+SimdDispatch& dispatch(void)
+{
+    static SimdDispatch d = {bestISA(), kernelsOf(bestISA())};
+    return d;
+}
+
+}
+
+SimdKernels scalarKernels(void)
+{
+    SimdKernels kernels = {&scalarExp, &scalarSigmoid, &scalarLog, &scalarDot8};
+    return kernels;
+}
+
+
+// void exp(double*, const size_t) method
+
+/// Replaces every element of the buffer with e^x, using the widest instruction set of this CPU.
+/// The vector kernels stay within 2.3e-16 relative error of libm (about 1 ulp) wherever e^x is a normal double.
+/// Results overflow to inf above 709.78 and underflow gradually to 0 below -708.4. NaN is passed through.
+/// @param x Buffer of doubles.
+/// @param n Number of elements.
+
+void SimdMath::exp(double* x, const size_t n)
+{
+    dispatch().kernels.exp(x, n);
+}
+
+
+// void sigmoid(double*, const size_t) method
+
+/// Replaces every element of the buffer with 1 / (1 + e^(-x)), using the widest instruction set of this CPU.
+/// The vector kernels stay within 5.5e-16 relative error of libm (about 2 ulp), and saturate to exactly 0 or 1.
+/// @param x Buffer of doubles.
+/// @param n Number of elements.
+
+void SimdMath::sigmoid(double* x, const size_t n)
+{
+    dispatch().kernels.sigmoid(x, n);
+}
+
+
+// void log(double*, const size_t) method
+
+/// Replaces every element of the buffer with its natural logarithm, using the widest instruction set of this CPU.
+/// The vector kernels stay within 1.6e-16 absolute error of libm where |log(x)| < 1, and 3.5e-16 relative error elsewhere,
+/// subnormals included. log(0) = -inf, log(x < 0) = NaN, log(inf) = inf.
+/// @param x Buffer of doubles.
+/// @param n Number of elements.
+
+void SimdMath::log(double* x, const size_t n)
+{
+    dispatch().kernels.log(x, n);
+}
+
+
+// int32_t dot8(const int8_t*, const int8_t*, const size_t) method
+
+/// Returns the dot product of two int8 vectors, accumulated exactly in int32, using the widest instruction set of
+/// this CPU. Exact for n < 2^17, the most products of magnitude <= 2^14 that an int32 can sum.
+/// @param a Vector of n int8.
+/// @param b Vector of n int8.
+/// @param n Number of elements.
+
+int32_t SimdMath::dot8(const int8_t* a, const int8_t* b, const size_t n)
+{
+    return dispatch().kernels.dot8(a, b, n);
+}
+
+
+// ISA isa(void) method
+
+/// Returns the instruction set the kernels currently dispatch to.
+
+SimdMath::ISA SimdMath::isa(void)
+{
+    return dispatch().isa;
+}
+
+
+// void set_isa(const ISA) method
+
+/// Forces the kernels onto the given instruction set. Not thread safe against concurrent kernel calls.
+/// @param isa Instruction set supported by this CPU.
+
+void SimdMath::set_isa(const ISA isa)
+{
+    if(!supported(isa))
+    {
+        cerr << "Regression: SimdMath class." << endl
+             << "void set_isa(const ISA) method." << endl
+             << "Instruction set: " << isaName(isa) << " is not supported by this CPU."
+             << endl;
+
+        exit(1);
+    }
+
+    dispatch().isa = isa;
+    dispatch().kernels = kernelsOf(isa);
+}
+
+
+// bool supported(const ISA) method
+
+/// Returns true if this CPU and OS support the given instruction set.
+/// @param isa Instruction set.
+
+bool SimdMath::supported(const ISA isa)
+{
+    switch(isa)
+    {
+    case Scalar:
+        return true;
+
+#if defined(__x86_64__) || defined(__i386__)
+    case SSE2:
+        return __builtin_cpu_supports("sse2");
+
+    case AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+
+    case AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+
+    default:
+        return false;
+    }
+}
+
+
+// string isaName(const ISA) method
+
+/// Returns the name of the given instruction set.
+/// @param isa Instruction set.
+
+string SimdMath::isaName(const ISA isa)
+{
+    switch(isa)
+    {
+    case Scalar:
+        return "Scalar(libm)";
+
+    case SSE2:
+        return "SSE2";
+
+    case AVX2:
+        return "AVX2";
+
+    case AVX512:
+        return "AVX-512";
+
+    default:
+        return "Unknown";
+    }
+}
+
+
+// void benchmark(const size_t, const unsigned int) method
+
+/// Prints the throughput of exp, sigmoid and log in elements per second for every supported instruction set,
+/// together with the max error against libm: relative, or absolute for log results smaller than 1 in magnitude.
+/// @param elements Buffer size > 0.
+/// @param repeats Number of timed passes over the buffer > 0.
+
+void SimdMath::benchmark(const size_t elements, const unsigned int repeats)
+{
+    if(!elements || !repeats)
+    {
+        cerr << "Regression: SimdMath class." << endl
+             << "void benchmark(const size_t, const unsigned int) method." << endl
+             << "Elements: " << elements << " and repeats: " << repeats << " must both be > 0."
+             << endl;
+
+        exit(1);
+    }
+
+    //--Logits in [-40, 40] for exp and sigmoid, positive values spanning many binades for log--//
+    vector<double> logits(elements);
+    vector<double> positives(elements);
+
+    for(size_t i=0; i<elements; i++)
+    {
+        logits[i] = (80.0 * rand() / RAND_MAX) - 40.0;
+        positives[i] = ::exp((80.0 * rand() / RAND_MAX) - 40.0);
+    }
+
+    vector<double> exp_ref(logits), sigmoid_ref(logits), log_ref(positives);
+
+    for(size_t i=0; i<elements; i++)
+    {
+        exp_ref[i] = ::exp(logits[i]);
+        sigmoid_ref[i] = 1.0 / (1.0 + ::exp(-logits[i]));
+        log_ref[i] = ::log(positives[i]);
+    }
+
+    ISA selected = isa();
+    vector<double> work(elements);
+
+    cout << endl << "SIMD math benchmark (" << elements << " elements x " << repeats << " passes, dispatch: " << isaName(selected) << ")"
+         << endl << "#ISA  #exp(elements/s)  #sigmoid(elements/s)  #log(elements/s)  #Max_error" << endl;
+
+    for(int i=Scalar; i<=AVX512; i++)
+    {
+        ISA row = (ISA) i;
+
+        if(!supported(row))
+        {
+            continue;
+        }
+
+        set_isa(row);
+
+        double rate[3];
+        double max_error = 0;
+
+        for(unsigned int f=0; f<3; f++)
+        {
+            const vector<double>& input = (f == 2) ? positives : logits;
+            const vector<double>& reference = (f == 0) ? exp_ref : ((f == 1) ? sigmoid_ref : log_ref);
+            double seconds = 0;
+
+            for(unsigned int r=0; r<repeats; r++)
+            {
+                work = input;
+                chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+                if(f == 0)
+                {
+                    exp(&work[0], elements);
+                }
+                else if(f == 1)
+                {
+                    sigmoid(&work[0], elements);
+                }
+                else
+                {
+                    log(&work[0], elements);
+                }
+
+                seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            }
+
+            rate[f] = ((double) elements * repeats) / seconds;
+
+            for(size_t e=0; e<elements; e++)
+            {
+                double scale = fabs(reference[e]);
+                scale = (f == 2 && scale < 1.0) ? 1.0 : scale;
+
+                double error = fabs(work[e] - reference[e]) / scale;
+                max_error = (error > max_error) ? error : max_error;
+            }
+        }
+
+        cout << isaName(row) << "  " << rate[0] << "  " << rate[1] << "  " << rate[2] << "  " << max_error << endl;
+    }
+
+    set_isa(selected);
+}
@@ -0,0 +1,44 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   S I M D   M A T H   C L A S S   H E A D E R                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+#include<iostream>
+#include<string>
+#include<stddef.h>
+#include<stdint.h>
+
+using namespace std;
+
+class SimdMath
+{
+public:
+    enum ISA{Scalar, SSE2, AVX2, AVX512};
+
+    static void exp(double*, const size_t);
+    static void sigmoid(double*, const size_t);
+    static void log(double*, const size_t);
+    static int32_t dot8(const int8_t*, const int8_t*, const size_t);
+
+    static ISA isa(void);
+    static void set_isa(const ISA);
+    static bool supported(const ISA);
+    static string isaName(const ISA);
+
+    static void benchmark(const size_t, const unsigned int);
+};
+
+#endif // SIMD_MATH_H
@@ -0,0 +1,108 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   S I M D   M A T H   A V X 2   K E R N E L S                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "simd_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include<immintrin.h>
+
+namespace
+{
+
+//--Four doubles per __m256d, with FMA; compiled with -mavx2 -mfma--//
+struct Avx2
+{
+    typedef __m256d V;
+    typedef __m256d M;
+
+    static const size_t width = 4;
+
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, const V v) { _mm256_storeu_pd(p, v); }
+    static V set1(const double a) { return _mm256_set1_pd(a); }
+
+    static V add(const V a, const V b) { return _mm256_add_pd(a, b); }
+    static V sub(const V a, const V b) { return _mm256_sub_pd(a, b); }
+    static V mul(const V a, const V b) { return _mm256_mul_pd(a, b); }
+    static V div(const V a, const V b) { return _mm256_div_pd(a, b); }
+    static V fma(const V a, const V b, const V c) { return _mm256_fmadd_pd(a, b, c); }
+    static V min(const V a, const V b) { return _mm256_min_pd(a, b); }
+    static V max(const V a, const V b) { return _mm256_max_pd(a, b); }
+
+    static M lt(const V a, const V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static M gt(const V a, const V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static M eq(const V a, const V b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static M isnan(const V a) { return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+    static V select(const M m, const V a, const V b) { return _mm256_blendv_pd(b, a, m); }
+
+    static V pow2(const V n)
+    {
+        __m256i bits = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(SIMD_MAGIC)));
+        bits = _mm256_add_epi64(bits, _mm256_set1_epi64x(1023));
+
+        return _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+    }
+
+    static V exponent(const V x)
+    {
+        __m256i bits = _mm256_srli_epi64(_mm256_castpd_si256(x), 52);
+        bits = _mm256_or_si256(bits, _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0)));
+
+        return _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(4503599627370496.0 + 1023.0));
+    }
+
+    static V mantissa(const V x)
+    {
+        __m256d fraction = _mm256_castsi256_pd(_mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+        return _mm256_or_pd(_mm256_and_pd(x, fraction), _mm256_set1_pd(1.0));
+    }
+
+    //--Σ a_i b_i of int8 vectors in int32: sixteen bytes sign-extended to int16, then pmaddwd--//
+    static int32_t dot8(const int8_t* a, const int8_t* b, const size_t n)
+    {
+        __m256i sum = _mm256_setzero_si256();
+        size_t i = 0;
+
+        for(; i + 16 <= n; i += 16)
+        {
+            __m256i va = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*) (a + i)));
+            __m256i vb = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*) (b + i)));
+
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(va, vb));
+        }
+
+        int32_t lanes[8];
+        _mm256_storeu_si256((__m256i*) lanes, sum);
+
+        int32_t dot = lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+
+        for(; i<n; i++)
+        {
+            dot += a[i] * b[i];
+        }
+
+        return dot;
+    }
+};
+
+}
+
+SimdKernels avx2Kernels(void)
+{
+    return makeKernels<Avx2>();
+}
+
+#endif
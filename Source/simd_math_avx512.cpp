@@ -0,0 +1,107 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   S I M D   M A T H   A V X - 5 1 2   K E R N E L S                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "simd_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include<immintrin.h>
+
+namespace
+{
+
+//--Eight doubles per __m512d with mask registers for compares; only AVX-512F is required--//
+struct Avx512
+{
+    typedef __m512d V;
+    typedef __mmask8 M;
+
+    static const size_t width = 8;
+
+    static V load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, const V v) { _mm512_storeu_pd(p, v); }
+    static V set1(const double a) { return _mm512_set1_pd(a); }
+
+    static V add(const V a, const V b) { return _mm512_add_pd(a, b); }
+    static V sub(const V a, const V b) { return _mm512_sub_pd(a, b); }
+    static V mul(const V a, const V b) { return _mm512_mul_pd(a, b); }
+    static V div(const V a, const V b) { return _mm512_div_pd(a, b); }
+    static V fma(const V a, const V b, const V c) { return _mm512_fmadd_pd(a, b, c); }
+    static V min(const V a, const V b) { return _mm512_min_pd(a, b); }
+    static V max(const V a, const V b) { return _mm512_max_pd(a, b); }
+
+    static M lt(const V a, const V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static M gt(const V a, const V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static M eq(const V a, const V b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static M isnan(const V a) { return _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q); }
+    static V select(const M m, const V a, const V b) { return _mm512_mask_blend_pd(m, b, a); }
+
+    static V pow2(const V n)
+    {
+        __m512i bits = _mm512_castpd_si512(_mm512_add_pd(n, _mm512_set1_pd(SIMD_MAGIC)));
+        bits = _mm512_add_epi64(bits, _mm512_set1_epi64(1023));
+
+        return _mm512_castsi512_pd(_mm512_slli_epi64(bits, 52));
+    }
+
+    static V exponent(const V x)
+    {
+        __m512i bits = _mm512_srli_epi64(_mm512_castpd_si512(x), 52);
+        bits = _mm512_or_si512(bits, _mm512_castpd_si512(_mm512_set1_pd(4503599627370496.0)));
+
+        return _mm512_sub_pd(_mm512_castsi512_pd(bits), _mm512_set1_pd(4503599627370496.0 + 1023.0));
+    }
+
+    static V mantissa(const V x)
+    {
+        __m512i bits = _mm512_and_si512(_mm512_castpd_si512(x), _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL));
+        bits = _mm512_or_si512(bits, _mm512_castpd_si512(_mm512_set1_pd(1.0)));
+
+        return _mm512_castsi512_pd(bits);
+    }
+
+    //--Σ a_i b_i of int8 vectors in int32: without AVX-512BW, sixteen bytes are sign-extended to int32--//
+    static int32_t dot8(const int8_t* a, const int8_t* b, const size_t n)
+    {
+        __m512i sum = _mm512_setzero_si512();
+        size_t i = 0;
+
+        for(; i + 16 <= n; i += 16)
+        {
+            __m512i va = _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*) (a + i)));
+            __m512i vb = _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*) (b + i)));
+
+            sum = _mm512_add_epi32(sum, _mm512_mullo_epi32(va, vb));
+        }
+
+        int32_t dot = _mm512_reduce_add_epi32(sum);
+
+        for(; i<n; i++)
+        {
+            dot += a[i] * b[i];
+        }
+
+        return dot;
+    }
+};
+
+}
+
+SimdKernels avx512Kernels(void)
+{
+    return makeKernels<Avx512>();
+}
+
+#endif
@@ -0,0 +1,113 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   S I M D   M A T H   S S E 2   K E R N E L S                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "simd_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include<emmintrin.h>
+
+namespace
+{
+
+//--Two doubles per __m128d; SSE2 has no blend or FMA, so both are composed from simpler ops--//
+struct Sse2
+{
+    typedef __m128d V;
+    typedef __m128d M;
+
+    static const size_t width = 2;
+
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, const V v) { _mm_storeu_pd(p, v); }
+    static V set1(const double a) { return _mm_set1_pd(a); }
+
+    static V add(const V a, const V b) { return _mm_add_pd(a, b); }
+    static V sub(const V a, const V b) { return _mm_sub_pd(a, b); }
+    static V mul(const V a, const V b) { return _mm_mul_pd(a, b); }
+    static V div(const V a, const V b) { return _mm_div_pd(a, b); }
+    static V fma(const V a, const V b, const V c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static V min(const V a, const V b) { return _mm_min_pd(a, b); }
+    static V max(const V a, const V b) { return _mm_max_pd(a, b); }
+
+    static M lt(const V a, const V b) { return _mm_cmplt_pd(a, b); }
+    static M gt(const V a, const V b) { return _mm_cmpgt_pd(a, b); }
+    static M eq(const V a, const V b) { return _mm_cmpeq_pd(a, b); }
+    static M isnan(const V a) { return _mm_cmpunord_pd(a, a); }
+    static V select(const M m, const V a, const V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+
+    static V pow2(const V n)
+    {
+        __m128i bits = _mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(SIMD_MAGIC)));
+        bits = _mm_add_epi64(bits, _mm_set1_epi64x(1023));
+
+        return _mm_castsi128_pd(_mm_slli_epi64(bits, 52));
+    }
+
+    static V exponent(const V x)
+    {
+        __m128i bits = _mm_srli_epi64(_mm_castpd_si128(x), 52);
+        bits = _mm_or_si128(bits, _mm_castpd_si128(_mm_set1_pd(4503599627370496.0)));
+
+        return _mm_sub_pd(_mm_castsi128_pd(bits), _mm_set1_pd(4503599627370496.0 + 1023.0));
+    }
+
+    static V mantissa(const V x)
+    {
+        __m128d fraction = _mm_castsi128_pd(_mm_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+        return _mm_or_pd(_mm_and_pd(x, fraction), _mm_set1_pd(1.0));
+    }
+
+    //--Σ a_i b_i of int8 vectors in int32: bytes are sign-extended to int16 by unpacking against their--//
+    //--sign mask, and pmaddwd sums adjacent products into int32 lanes                                --//
+    static int32_t dot8(const int8_t* a, const int8_t* b, const size_t n)
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128i sum = zero;
+        size_t i = 0;
+
+        for(; i + 16 <= n; i += 16)
+        {
+            __m128i va = _mm_loadu_si128((const __m128i*) (a + i));
+            __m128i vb = _mm_loadu_si128((const __m128i*) (b + i));
+            __m128i sa = _mm_cmpgt_epi8(zero, va);
+            __m128i sb = _mm_cmpgt_epi8(zero, vb);
+
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi8(va, sa), _mm_unpacklo_epi8(vb, sb)));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpackhi_epi8(va, sa), _mm_unpackhi_epi8(vb, sb)));
+        }
+
+        int32_t lanes[4];
+        _mm_storeu_si128((__m128i*) lanes, sum);
+
+        int32_t dot = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+        for(; i<n; i++)
+        {
+            dot += a[i] * b[i];
+        }
+
+        return dot;
+    }
+};
+
+}
+
+SimdKernels sse2Kernels(void)
+{
+    return makeKernels<Sse2>();
+}
+
+#endif
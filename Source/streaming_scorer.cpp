@@ -0,0 +1,293 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   S T R E A M I N G   S C O R E R   C L A S S                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "streaming_scorer.h"
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<fstream>
+#include<thread>
+#include<vector>
+#include<functional>
+
+
+// CONSTRUCTOR
+
+/// Maps the model file to score with.
+/// @param modelFile Path of a model file written by Predictor::save().
+
+StreamingScorer::StreamingScorer(const string& modelFile):d_model(modelFile),
+    d_ThetaT(const_cast<double*>(d_model.theta()), d_model.K(), d_model.features() + 1, false, true)
+{
+}
+
+
+// unsigned long score(const string&, const string&) const method
+
+/// Scores every instance of a data file and returns the number of instances scored.
+/// The input has one instance per line of at least N() whitespace separated attributes; further columns, such as
+/// a target, are ignored, as are lines containing '#'. Each output line holds the predicted label followed by the
+/// K() outputs of h_Ө(x) for a classifier, or the K() predictions of a regression model, in input order.
+/// @param inputFile Path of the data file.
+/// @param outputFile Path of the results file.
+
+unsigned long StreamingScorer::score(const string& inputFile, const string& outputFile) const
+{
+    vector<Chunk> chunks(SCORER_CHUNKS);
+
+    Channel free_chunks;
+    Channel parsed;
+    Channel scored;
+
+    for(unsigned int c=0; c<SCORER_CHUNKS; c++)
+    {
+        chunks[c].X.set_size(d_model.N(), SCORER_CHUNK);
+        free_chunks.push(&chunks[c]);
+    }
+
+    unsigned long instances = 0;
+
+    thread reader(&StreamingScorer::read, this, cref(inputFile), ref(free_chunks), ref(parsed));
+    thread computer(&StreamingScorer::compute, this, ref(parsed), ref(scored));
+    thread writer(&StreamingScorer::write, this, cref(outputFile), ref(scored), ref(free_chunks), ref(instances));
+
+    reader.join();
+    computer.join();
+    writer.join();
+
+    return instances;
+}
+
+
+// void read(const string&, Channel&, Channel&) const method
+
+/// Reader stage: parses the input into free chunks and passes them on, the last one flagged.
+/// @param inputFile Path of the data file.
+/// @param in Free chunks.
+/// @param out Parsed chunks.
+
+void StreamingScorer::read(const string& inputFile, Channel& in, Channel& out) const
+{
+    fstream file;
+    file.open(inputFile.c_str(), ios_base::in);
+
+    if(!file.is_open())
+    {
+        cerr << "Regression: StreamingScorer class." << endl
+             << "void read(const string&, Channel&, Channel&) const method." << endl
+             << "Cannot open data file: " << inputFile
+             << endl;
+
+        exit(1);
+    }
+
+    unsigned int n = d_model.N();
+    unsigned long line_number = 0;
+    string line;
+    bool last = false;
+
+    while(!last)
+    {
+        Chunk* chunk = in.pop();
+        chunk->rows = 0;
+
+        while(chunk->rows < SCORER_CHUNK)
+        {
+            if(!getline(file, line))
+            {
+                last = true;
+                break;
+            }
+            line_number++;
+
+            //--Omitting comments and blank lines--//
+            if(line.find("#") != string::npos || line.find_first_not_of(" \t\r") == string::npos)
+            {
+                continue;
+            }
+
+            double* x = chunk->X.colptr(chunk->rows);
+            const char* at = line.c_str();
+
+            for(unsigned int j=0; j<n; j++)
+            {
+                char* end;
+                x[j] = strtod(at, &end);
+
+                if(end == at)
+                {
+                    cerr << "Regression: StreamingScorer class." << endl
+                         << "void read(const string&, Channel&, Channel&) const method." << endl
+                         << "Line " << line_number << " of " << inputFile << " has fewer than " << n << " attributes."
+                         << endl;
+
+                    exit(1);
+                }
+
+                at = end;
+            }
+
+            chunk->rows++;
+        }
+
+        chunk->last = last;
+        out.push(chunk);
+    }
+
+    file.close();
+}
+
+
+// void compute(Channel&, Channel&) const method
+
+/// Compute stage: maps and normalizes the instances of each chunk into the columns of [1; X̂'], and
+/// computes h = g(Ө'[1; X̂']) with one GEMM.
+/// @param in Parsed chunks.
+/// @param out Scored chunks.
+
+void StreamingScorer::compute(Channel& in, Channel& out) const
+{
+    mat X_hat(d_model.features() + 1, SCORER_CHUNK);
+    X_hat.row(0).ones();
+
+    bool last = false;
+
+    while(!last)
+    {
+        Chunk* chunk = in.pop();
+        last = chunk->last;
+
+        if(chunk->rows)
+        {
+            for(unsigned int i=0; i<chunk->rows; i++)
+            {
+                d_model.features(chunk->X.colptr(i), X_hat.colptr(i) + 1);
+            }
+
+            chunk->H = d_ThetaT * X_hat.cols(0, chunk->rows - 1);
+
+            for(unsigned int i=0; i<chunk->rows; i++)
+            {
+                d_model.applyLink(chunk->H.colptr(i));
+            }
+        }
+
+        out.push(chunk);
+    }
+}
+
+
+// void write(const string&, Channel&, Channel&, unsigned long&) const method
+
+/// Writer stage: formats the results of each chunk, writes them in one go and returns the chunk to the reader.
+/// @param outputFile Path of the results file.
+/// @param in Scored chunks.
+/// @param out Free chunks.
+/// @param instances Number of instances written.
+
+void StreamingScorer::write(const string& outputFile, Channel& in, Channel& out, unsigned long& instances) const
+{
+    FILE* file = fopen(outputFile.c_str(), "w");
+
+    if(file == NULL)
+    {
+        cerr << "Regression: StreamingScorer class." << endl
+             << "void write(const string&, Channel&, Channel&, unsigned long&) const method." << endl
+             << "Cannot open results file: " << outputFile
+             << endl;
+
+        exit(1);
+    }
+
+    unsigned int K = d_model.K();
+    bool classifier = d_model.labels() > 0;
+    char field[32];
+    bool last = false;
+
+    while(!last)
+    {
+        Chunk* chunk = in.pop();
+        last = chunk->last;
+
+        chunk->text.clear();
+
+        for(unsigned int i=0; i<chunk->rows; i++)
+        {
+            const double* h = chunk->H.colptr(i);
+
+            if(classifier)
+            {
+                //--The links are monotone, so the arg max of h is the arg max of the logits--//
+                snprintf(field, sizeof(field), "%.10g", d_model.label(frozenArgmax(h, K)));
+                chunk->text += field;
+            }
+
+            for(unsigned int k=0; k<K; k++)
+            {
+                snprintf(field, sizeof(field), (classifier || k) ? " %.10g" : "%.10g", h[k]);
+                chunk->text += field;
+            }
+
+            chunk->text += '\n';
+        }
+
+        if(fwrite(chunk->text.data(), 1, chunk->text.size(), file) != chunk->text.size())
+        {
+            cerr << "Regression: StreamingScorer class." << endl
+                 << "void write(const string&, Channel&, Channel&, unsigned long&) const method." << endl
+                 << "Cannot write results file: " << outputFile
+                 << endl;
+
+            exit(1);
+        }
+
+        instances += chunk->rows;
+        out.push(chunk);
+    }
+
+    fclose(file);
+}
+
+
+// void push(Chunk*) method
+
+/// Hands a chunk to the next stage.
+/// @param chunk Chunk.
+
+void StreamingScorer::Channel::push(Chunk* chunk)
+{
+    {
+        unique_lock<mutex> lock(d_mutex);
+        d_chunks.push_back(chunk);
+    }
+
+    d_ready.notify_one();
+}
+
+
+// Chunk* pop(void) method
+
+/// Waits for the next chunk from the previous stage.
+
+StreamingScorer::Chunk* StreamingScorer::Channel::pop(void)
+{
+    unique_lock<mutex> lock(d_mutex);
+    d_ready.wait(lock, [this]{return !d_chunks.empty();});
+
+    Chunk* chunk = d_chunks.front();
+    d_chunks.pop_front();
+
+    return chunk;
+}
@@ -0,0 +1,75 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   S T R E A M I N G   S C O R E R   C L A S S   H E A D E R                              */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef STREAMING_SCORER_H
+#define STREAMING_SCORER_H
+
+#include<iostream>
+#include<string>
+#include<deque>
+#include<mutex>
+#include<condition_variable>
+
+#include "armadillo"
+#include "inference_model.h"
+
+using namespace std;
+using namespace arma;
+
+#define SCORER_CHUNK 4096       //--Instances per chunk--//
+#define SCORER_CHUNKS 4         //--Chunks in flight between the stages; bounds the memory of a run--//
+
+//--Scores a data file of any size with a model file, in three overlapped stages on their own threads:--//
+//--read and parse a chunk of instances, map them and compute h_Ө with one GEMM, format and write the  --//
+//--results. A fixed set of chunks cycles through the stages, so memory stays constant.               --//
+class StreamingScorer
+{
+public:
+    StreamingScorer(const string&);
+
+    unsigned long score(const string&, const string&) const;
+
+private:
+    struct Chunk
+    {
+        mat X;                  //--Raw instances, one per column--//
+        mat H;                  //--Predictions, one per column--//
+        unsigned int rows;
+        bool last;
+        string text;
+    };
+
+    //--Hands chunks from one stage to the next--//
+    class Channel
+    {
+    public:
+        void push(Chunk*);
+        Chunk* pop(void);
+
+    private:
+        deque<Chunk*> d_chunks;
+        mutex d_mutex;
+        condition_variable d_ready;
+    };
+
+    void read(const string&, Channel&, Channel&) const;
+    void compute(Channel&, Channel&) const;
+    void write(const string&, Channel&, Channel&, unsigned long&) const;
+
+    InferenceModel d_model;
+    mat d_ThetaT;               //--Kx(F+1) view of the mapped Ө--//
+};
+
+#endif // STREAMING_SCORER_H
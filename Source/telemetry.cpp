@@ -0,0 +1,160 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   T E L E M E T R Y   C L A S S                                                          */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "telemetry.h"
+
+// CONSTRUCTOR
+
+/// Creates a closed telemetry channel. Records are dropped until it is opened with a sink other than None.
+
+Telemetry::Telemetry():d_head(0), d_tail(0), d_running(false)
+{
+    d_sink = None;
+}
+
+
+// DESTRUCTOR
+
+/// Drains the pending records and stops the background writer.
+
+Telemetry::~Telemetry()
+{
+    close();
+}
+
+
+// void open(const Sink, const string&, const string&, const bool) method
+
+/// Opens the output file and starts the background writer that drains the ring buffer into it.
+/// A Text sink writes the header and one "x y" line per record; a Binary sink writes raw pairs of doubles.
+/// @param sink Type of sink: None, Text or Binary.
+/// @param path Path and name of the output file.
+/// @param header Header line of a Text sink, written only when the file is truncated.
+/// @param append Appends to an existing file instead of truncating it.
+
+void Telemetry::open(const Sink sink, const string& path, const string& header, const bool append)
+{
+    close();
+
+    d_sink = sink;
+    if(d_sink == None)
+    {
+        return;
+    }
+
+    ios_base::openmode mode = ios_base::out | (append ? ios_base::app : ios_base::trunc);
+    if(d_sink == Binary)
+    {
+        mode |= ios_base::binary;
+    }
+
+    d_file.open(path.c_str(), mode);
+    if(!d_file.is_open())
+    {
+        cerr << "Regression: Telemetry class." << endl
+             << "void open(const Sink, const string&, const string&, const bool) method" << endl
+             << "Cannot open telemetry file: "<< path  << endl;
+
+        exit(1);
+    }
+
+    if(d_sink == Text && !append)
+    {
+        d_file << header << '\n';
+    }
+
+    d_ring.resize(TELEMETRY_CAPACITY);
+    d_head.store(0);
+    d_tail.store(0);
+
+    d_running.store(true);
+    d_writer = thread(&Telemetry::writer, this);
+}
+
+
+// void close(void) method
+
+/// Waits for the background writer to drain the ring buffer, then closes the output file.
+
+void Telemetry::close(void)
+{
+    if(d_writer.joinable())
+    {
+        d_running.store(false, memory_order_release);
+        d_writer.join();
+    }
+
+    if(d_file.is_open())
+    {
+        d_file.close();
+    }
+
+    d_sink = None;
+}
+
+
+// bool isOpen(void) const method
+
+/// Returns true if records are currently being written to a sink.
+
+bool Telemetry::isOpen(void) const
+{
+    return d_sink != None;
+}
+
+
+// void writer(void) method
+
+/// Background writer loop: drains batches of records into the buffered output file.
+/// Exits once the channel is closed and the ring buffer is empty.
+
+void Telemetry::writer(void)
+{
+    while(true)
+    {
+        bool running = d_running.load(memory_order_acquire);
+        unsigned long tail = d_tail.load(memory_order_relaxed);
+        unsigned long head = d_head.load(memory_order_acquire);
+
+        if(tail == head)
+        {
+            if(!running)
+            {
+                break;
+            }
+
+            this_thread::sleep_for(chrono::milliseconds(1));
+            continue;
+        }
+
+        for(; tail != head; tail++)
+        {
+            const Record& r = d_ring[tail & (TELEMETRY_CAPACITY - 1)];
+
+            if(d_sink == Binary)
+            {
+                d_file.write((const char*) &r, sizeof(Record));
+            }
+            else
+            {
+                d_file << r.x << ' ' << r.y << '\n';
+            }
+        }
+
+        d_tail.store(tail, memory_order_release);
+    }
+
+    d_file.flush();
+}
@@ -0,0 +1,95 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   T E L E M E T R Y   C L A S S   H E A D E R                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include<iostream>
+#include<fstream>
+#include<string>
+#include<vector>
+#include<thread>
+#include<atomic>
+#include<chrono>
+
+using namespace std;
+
+//--Ring buffer capacity in records; must be a power of 2--//
+#define TELEMETRY_CAPACITY 4096
+
+class Telemetry
+{
+public:
+    enum Sink{None, Text, Binary};
+
+    Telemetry();
+    ~Telemetry();
+
+    void open(const Sink, const string&, const string&, const bool);
+    void close(void);
+    bool isOpen(void) const;
+
+    inline void record(const double, const double);
+
+private:
+    struct Record
+    {
+        double x;
+        double y;
+    };
+
+    void writer(void);
+
+    Sink d_sink;
+    ofstream d_file;
+
+    vector<Record> d_ring;
+    atomic<unsigned long> d_head;
+    atomic<unsigned long> d_tail;
+
+    atomic<bool> d_running;
+    thread d_writer;
+};
+
+
+// inline void record(const double, const double) method
+
+/// Pushes a record onto the ring buffer, to be written by the background writer.
+/// Returns immediately when the sink is None; blocks only while the ring buffer is full.
+/// @param x First field of the record, e.g. the iteration or λ.
+/// @param y Second field of the record, e.g. J(Ө).
+
+inline void Telemetry::record(const double x, const double y)
+{
+    if(d_sink == None)
+    {
+        return;
+    }
+
+    unsigned long head = d_head.load(memory_order_relaxed);
+
+    while(head - d_tail.load(memory_order_acquire) >= TELEMETRY_CAPACITY)
+    {
+        this_thread::yield();
+    }
+
+    Record& r = d_ring[head & (TELEMETRY_CAPACITY - 1)];
+    r.x = x;
+    r.y = y;
+
+    d_head.store(head + 1, memory_order_release);
+}
+
+#endif // TELEMETRY_H
@@ -0,0 +1,136 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   T H R E A D   P O O L   C L A S S                                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "thread_pool.h"
+
+// CONSTRUCTOR
+
+/// Creates a pool of worker threads that execute enqueued tasks.
+/// @param threads Number of worker threads > 0.
+
+ThreadPool::ThreadPool(const unsigned int threads)
+{
+    if(!threads)
+    {
+        cerr << "Regression: ThreadPool class." << endl
+             << "ThreadPool(const unsigned int) constructor." << endl
+             << "Number of threads: " << threads << " must be > 0."
+             << endl;
+
+        exit(1);
+    }
+
+    d_active = 0;
+    d_stop = false;
+
+    for(unsigned int t=0; t<threads; t++)
+    {
+        d_workers.push_back(thread(&ThreadPool::worker, this));
+    }
+}
+
+
+// DESTRUCTOR
+
+/// Finishes the pending tasks and joins the worker threads.
+
+ThreadPool::~ThreadPool()
+{
+    {
+        unique_lock<mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_task_ready.notify_all();
+
+    for(unsigned int t=0; t<d_workers.size(); t++)
+    {
+        d_workers[t].join();
+    }
+}
+
+
+// void enqueue(const function<void()>&) method
+
+/// Adds a task to the queue, to be run by the first idle worker.
+/// @param task Task to be executed.
+
+void ThreadPool::enqueue(const function<void()>& task)
+{
+    {
+        unique_lock<mutex> lock(d_mutex);
+        d_tasks.push(task);
+    }
+    d_task_ready.notify_one();
+}
+
+
+// void wait(void) method
+
+/// Blocks until every enqueued task has finished.
+
+void ThreadPool::wait(void)
+{
+    unique_lock<mutex> lock(d_mutex);
+    d_all_done.wait(lock, [this]{ return d_tasks.empty() && !d_active; });
+}
+
+
+// unsigned int size(void) const method
+
+/// Returns the number of worker threads in the pool.
+
+unsigned int ThreadPool::size(void) const
+{
+    return d_workers.size();
+}
+
+
+// void worker(void) method
+
+/// Worker loop: takes tasks from the queue until the pool is stopped and the queue is drained.
+
+void ThreadPool::worker(void)
+{
+    while(true)
+    {
+        function<void()> task;
+
+        {
+            unique_lock<mutex> lock(d_mutex);
+            d_task_ready.wait(lock, [this]{ return d_stop || !d_tasks.empty(); });
+
+            if(d_tasks.empty())
+            {
+                return;
+            }
+
+            task = d_tasks.front();
+            d_tasks.pop();
+            d_active++;
+        }
+
+        task();
+
+        {
+            unique_lock<mutex> lock(d_mutex);
+            d_active--;
+
+            if(d_tasks.empty() && !d_active)
+            {
+                d_all_done.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   T H R E A D   P O O L   C L A S S   H E A D E R                                        */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include<iostream>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<functional>
+#include<queue>
+#include<vector>
+
+using namespace std;
+
+class ThreadPool
+{
+public:
+    ThreadPool(const unsigned int);
+    ~ThreadPool();
+
+    void enqueue(const function<void()>&);
+    void wait(void);
+
+    unsigned int size(void) const;
+
+private:
+    void worker(void);
+
+    vector<thread> d_workers;
+    queue< function<void()> > d_tasks;
+
+    mutex d_mutex;
+    condition_variable d_task_ready;
+    condition_variable d_all_done;
+
+    unsigned int d_active;
+    bool d_stop;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,170 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   T R A I N I N G   O B S E R V E R   C L A S S                                          */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "training_observer.h"
+
+// CONSTRUCTOR
+
+/// Creates an observer that exports per-iteration training metrics to a file.
+/// JSONLines appends one JSON object per iteration.
+/// Prometheus keeps a text exposition file of the latest iteration, rewritten atomically at most once per second,
+/// suitable for the node exporter textfile collector.
+/// @param path Path and name of the output file.
+/// @param format Output format: "JSONLines" or "Prometheus".
+
+MetricsExporter::MetricsExporter(const string& path, const string& format):d_path(path)
+{
+    if(format == "JSONLines")
+    {
+        d_format = JSONLines;
+
+        d_file.open(d_path.c_str(), ios_base::out | ios_base::trunc);
+        if(!d_file.is_open())
+        {
+            cerr << "Regression: MetricsExporter class." << endl
+                 << "MetricsExporter(const string&, const string&) constructor." << endl
+                 << "Cannot open metrics file: " << d_path
+                 << endl;
+
+            exit(1);
+        }
+    }
+    else if(format == "Prometheus")
+    {
+        d_format = Prometheus;
+    }
+    else
+    {
+        cerr << "Regression: MetricsExporter class." << endl
+             << "MetricsExporter(const string&, const string&) constructor." << endl
+             << "Invalid metrics format: " << format
+             << endl;
+
+        exit(1);
+    }
+
+    d_pending = false;
+    d_last_write = chrono::steady_clock::now();
+}
+
+
+// DESTRUCTOR
+
+/// Writes the metrics of the last iteration, if not yet exported, and closes the output file.
+
+MetricsExporter::~MetricsExporter()
+{
+    if(d_format == Prometheus && d_pending)
+    {
+        writePrometheus();
+    }
+
+    if(d_file.is_open())
+    {
+        d_file.close();
+    }
+}
+
+
+// void onIteration(const IterationMetrics&) method
+
+/// Exports the metrics of one training iteration.
+/// @param metrics Metrics of the iteration.
+
+void MetricsExporter::onIteration(const IterationMetrics& metrics)
+{
+    if(d_format == JSONLines)
+    {
+        d_file << "{\"iteration\":" << metrics.iteration
+               << ",\"wall_time\":" << metrics.wall_time
+               << ",\"rows_per_sec\":" << metrics.rows_per_sec
+               << ",\"gflops\":" << metrics.gflops
+               << ",\"gradient_norm\":" << metrics.gradient_norm
+               << ",\"step_size\":" << metrics.step_size
+               << ",\"cost\":" << metrics.cost << "}\n";
+
+        return;
+    }
+
+    d_last = metrics;
+    d_pending = true;
+
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    if(now - d_last_write >= chrono::seconds(1))
+    {
+        writePrometheus();
+
+        d_pending = false;
+        d_last_write = now;
+    }
+}
+
+
+// string format(void) const method
+
+/// Returns the output format of the exporter.
+
+string MetricsExporter::format(void) const
+{
+    return (d_format == JSONLines) ? "JSONLines" : "Prometheus";
+}
+
+
+// void writePrometheus(void) const method
+
+/// Writes the metrics of the last iteration in Prometheus text exposition format.
+/// The file is written under a temporary name and renamed, so a scrape never reads a partial file.
+
+void MetricsExporter::writePrometheus(void) const
+{
+    string tmp_path = d_path + ".tmp";
+
+    ofstream prom(tmp_path.c_str(), ios_base::out | ios_base::trunc);
+    if(!prom.is_open())
+    {
+        cerr << "Regression: MetricsExporter class." << endl
+             << "void writePrometheus(void) const method" << endl
+             << "Cannot open metrics file: " << tmp_path
+             << endl;
+
+        return;
+    }
+
+    prom << "# HELP regression_iteration Current training iteration." << '\n'
+         << "# TYPE regression_iteration gauge" << '\n'
+         << "regression_iteration " << d_last.iteration << '\n'
+         << "# HELP regression_iteration_seconds Wall time of the last iteration." << '\n'
+         << "# TYPE regression_iteration_seconds gauge" << '\n'
+         << "regression_iteration_seconds " << d_last.wall_time << '\n'
+         << "# HELP regression_rows_per_second Training instances processed per second." << '\n'
+         << "# TYPE regression_rows_per_second gauge" << '\n'
+         << "regression_rows_per_second " << d_last.rows_per_sec << '\n'
+         << "# HELP regression_gflops GFLOP/s of the GEMMs of the last iteration." << '\n'
+         << "# TYPE regression_gflops gauge" << '\n'
+         << "regression_gflops " << d_last.gflops << '\n'
+         << "# HELP regression_gradient_norm Frobenius norm of the cost gradient." << '\n'
+         << "# TYPE regression_gradient_norm gauge" << '\n'
+         << "regression_gradient_norm " << d_last.gradient_norm << '\n'
+         << "# HELP regression_step_size Gradient descent step size alpha/m." << '\n'
+         << "# TYPE regression_step_size gauge" << '\n'
+         << "regression_step_size " << d_last.step_size << '\n'
+         << "# HELP regression_cost Training cost J(Theta)." << '\n'
+         << "# TYPE regression_cost gauge" << '\n'
+         << "regression_cost " << d_last.cost << '\n';
+
+    prom.close();
+
+    rename(tmp_path.c_str(), d_path.c_str());
+}
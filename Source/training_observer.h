@@ -0,0 +1,70 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   T R A I N I N G   O B S E R V E R   C L A S S   H E A D E R                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef TRAINING_OBSERVER_H
+#define TRAINING_OBSERVER_H
+
+#include<iostream>
+#include<fstream>
+#include<string>
+#include<chrono>
+#include<stdio.h>
+
+using namespace std;
+
+struct IterationMetrics
+{
+    unsigned int iteration;
+    double wall_time;           //--Seconds spent in the iteration--//
+    double rows_per_sec;        //--Training instances processed per second--//
+    double gflops;              //--GFLOP/s achieved by the GEMMs of the iteration--//
+    double gradient_norm;       //--Frobenius norm of ∂J(Ө)/∂Ө--//
+    double step_size;           //--𝛼/m--//
+    double cost;                //--J(Ө) after the update--//
+};
+
+class TrainingObserver
+{
+public:
+    virtual ~TrainingObserver() {}
+
+    virtual void onIteration(const IterationMetrics&) = 0;
+};
+
+class MetricsExporter: public TrainingObserver
+{
+public:
+    enum Format{JSONLines, Prometheus};
+
+    MetricsExporter(const string&, const string&);
+    ~MetricsExporter();
+
+    virtual void onIteration(const IterationMetrics&);
+
+    string format(void) const;
+
+private:
+    void writePrometheus(void) const;
+
+    Format d_format;
+    string d_path;
+    ofstream d_file;
+
+    IterationMetrics d_last;
+    bool d_pending;
+    chrono::steady_clock::time_point d_last_write;
+};
+
+#endif // TRAINING_OBSERVER_H
@@ -0,0 +1,189 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   Regression: A C++ library for Linear and Logistic Regression.                          */
+/*                                                                                          */
+/*   W O R K S P A C E   A L L O C A T I O N   T E S T                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   https://sites.google.com/site/anashranga/                                              */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include<stdlib.h>
+#include<errno.h>
+#include<malloc.h>
+#include<atomic>
+#include<new>
+
+#include "../Source/dataset.h"
+#include "../Source/data_view.h"
+#include "../Source/linear_regression.h"
+#include "../Source/logistic_regression.h"
+
+#define WARMUP_ITERATIONS 5
+#define STEADY_ITERATIONS 50
+
+//--Counts every heap allocation of the process. Armadillo takes its memory through posix_memalign or--//
+//--malloc rather than operator new, so the C allocator is replaced as well, forwarding to glibc's own. --//
+
+static atomic<unsigned long> g_allocations(0);
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+
+    void* malloc(size_t bytes) __THROW
+    {
+        g_allocations++;
+        return __libc_malloc(bytes);
+    }
+
+    void* calloc(size_t count, size_t bytes) __THROW
+    {
+        g_allocations++;
+        return __libc_calloc(count, bytes);
+    }
+
+    void* realloc(void* p, size_t bytes) __THROW
+    {
+        g_allocations++;
+        return __libc_realloc(p, bytes);
+    }
+
+    void* memalign(size_t alignment, size_t bytes) __THROW
+    {
+        g_allocations++;
+        return __libc_memalign(alignment, bytes);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t bytes) __THROW
+    {
+        g_allocations++;
+        return __libc_memalign(alignment, bytes);
+    }
+
+    int posix_memalign(void** p, size_t alignment, size_t bytes) __THROW
+    {
+        g_allocations++;
+        *p = __libc_memalign(alignment, bytes);
+        return *p ? 0 : ENOMEM;
+    }
+
+    void free(void* p) __THROW
+    {
+        __libc_free(p);
+    }
+}
+
+void* operator new(size_t bytes)
+{
+    g_allocations++;
+    void* p = __libc_malloc(bytes ? bytes : 1);
+
+    if(!p)
+    {
+        throw bad_alloc();
+    }
+
+    return p;
+}
+
+void* operator new[](size_t bytes)
+{
+    return operator new(bytes);
+}
+
+void operator delete(void* p) noexcept
+{
+    __libc_free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    __libc_free(p);
+}
+
+
+//--Opens descend() to the test. delta < 0 never converges, so each call runs exactly its iterations.--//
+template<class Model> class WorkspaceProbe: public Model
+{
+public:
+    WorkspaceProbe(const DataSet& ds):Model(ds) {}
+
+    unsigned long allocations(const DataView& view, const unsigned int iterations)
+    {
+        unsigned int it = 0;
+        double c_prev = 0;
+
+        unsigned long before = g_allocations.load();
+        this->descend(view, -1.0, iterations, it, c_prev, NULL, NULL);
+
+        return g_allocations.load() - before;
+    }
+};
+
+
+//--Runs descend() once to size the workspace, then compares a short and a long run from it: the--//
+//--per-call setup is the same for both, so any difference was allocated by the extra iterations.--//
+template<class Model> bool steadyStateAllocationFree(WorkspaceProbe<Model>& model, const DataView& view, const char* kernel)
+{
+    model.allocations(view, WARMUP_ITERATIONS);
+
+    unsigned long short_run = model.allocations(view, WARMUP_ITERATIONS);
+    unsigned long long_run = model.allocations(view, WARMUP_ITERATIONS + STEADY_ITERATIONS);
+
+    bool pass = (long_run == short_run);
+
+    cout << (pass ? "PASS " : "FAIL ") << kernel << ": " << (long_run - short_run) << " allocations over "
+         << STEADY_ITERATIONS << " steady-state iterations" << endl;
+
+    return pass;
+}
+
+
+int main(int argc, char* argv[])
+{
+    if(argc != 3)
+    {
+        cerr << "Regression: Workspace allocation test." << endl
+             << "int main(int, char*) method" << endl
+             << "Usage: " << argv[0] << " <classification data file> <regression data file>"
+             << endl;
+
+        return 1;
+    }
+
+    bool pass = true;
+
+    //--Identity link with squared loss, over a dense training matrix--//
+    DataSet house(argv[2], 1, 70, 30, false, false);
+
+    WorkspaceProbe<LinearRegression> linR(house);
+    DataView house_view(house.XTrain(), house.yTrain(), DataView::Targets);
+
+    pass &= steadyStateAllocationFree(linR, house_view, "Identity/Squared");
+
+    //--Sigmoid and softmax links with cross-entropy, through the row indices of the training split--//
+    DataSet chip(argv[1], 2, 70, 30, false, true);
+    DataView chip_view(chip.X(), chip.classIndices(), DataView::ClassIndices, chip.trainRows());
+
+    WorkspaceProbe<LogisticRegression> sigmoid(chip);
+    sigmoid.set_classificationFunction("Sigmoid");
+
+    pass &= steadyStateAllocationFree(sigmoid, chip_view, "Sigmoid/CrossEntropy");
+
+    WorkspaceProbe<LogisticRegression> softmax(chip);
+    softmax.set_classificationFunction("Softmax");
+
+    pass &= steadyStateAllocationFree(softmax, chip_view, "Softmax/CrossEntropy");
+
+    return pass ? 0 : 1;
+}